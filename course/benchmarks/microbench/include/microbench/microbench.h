@@ -0,0 +1,133 @@
+// Copyright 2020, Ekumen
+//
+// microbench: a small micro-benchmark harness modelled after Google
+// Benchmark. Benchmarks are plain functions taking a State, registered with
+// MICROBENCH() and optionally parameterized with one or more arguments:
+//
+//   void BM_Something(microbench::State &state) {
+//     const std::size_t n = state.range(0);
+//     while (state.KeepRunning()) {
+//       ...
+//     }
+//     state.SetItemsProcessed(state.iterations() * n);
+//   }
+//   MICROBENCH(BM_Something)->Arg(1)->Arg(64)->Arg(4096);
+//
+// Results are printed as a table and, with --benchmark_out=<file>, also
+// written as JSON using the same layout as Google Benchmark so existing
+// comparison tooling can diff two runs.
+
+#ifndef MICROBENCH_MICROBENCH_H_
+#define MICROBENCH_MICROBENCH_H_
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace microbench {
+
+// Prevents the compiler from optimizing away the computation of |value|.
+template <typename T>
+inline void DoNotOptimize(const T &value) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T *sink;
+  sink = &value;
+#endif
+}
+
+// Forces the compiler to assume that any memory may have been modified.
+inline void ClobberMemory() {
+#if defined(__GNUC__)
+  asm volatile("" : : : "memory");
+#endif
+}
+
+class State {
+ public:
+  State(std::int64_t max_iterations, std::vector<std::int64_t> ranges);
+
+  // Returns true while the timed loop must keep running. Timing starts on
+  // the first call and stops on the call that returns false.
+  bool KeepRunning();
+
+  std::int64_t range(std::size_t index = 0) const;
+  std::int64_t iterations() const { return max_iterations_; }
+
+  void PauseTiming();
+  void ResumeTiming();
+
+  void SetItemsProcessed(std::int64_t items) { items_processed_ = items; }
+  std::int64_t items_processed() const { return items_processed_; }
+
+  double real_time_seconds() const { return real_time_; }
+  double cpu_time_seconds() const { return cpu_time_; }
+
+ private:
+  void StartTimer();
+  void StopTimer();
+
+  const std::int64_t max_iterations_;
+  const std::vector<std::int64_t> ranges_;
+  std::int64_t iterations_left_;
+  bool started_{false};
+  bool running_{false};
+  std::int64_t items_processed_{0};
+  std::chrono::steady_clock::time_point real_start_;
+  std::clock_t cpu_start_{0};
+  double real_time_{0.};
+  double cpu_time_{0.};
+};
+
+typedef void (*Function)(State &);
+
+class Benchmark {
+ public:
+  Benchmark(const std::string &name, Function function);
+
+  Benchmark *Arg(std::int64_t arg);
+  Benchmark *Args(const std::vector<std::int64_t> &args);
+
+  const std::string &name() const { return name_; }
+  Function function() const { return function_; }
+  const std::vector<std::vector<std::int64_t>> &args() const { return args_; }
+
+ private:
+  std::string name_;
+  Function function_;
+  std::vector<std::vector<std::int64_t>> args_;
+};
+
+// Registers a benchmark. The returned object is owned by the harness.
+Benchmark *RegisterBenchmark(const std::string &name, Function function);
+
+// Parses the --benchmark_* flags out of argv. Returns false on bad flags.
+bool Initialize(int *argc, char **argv);
+
+// Runs every registered benchmark matching the filter. Returns the number
+// of benchmarks that were run.
+std::size_t RunSpecifiedBenchmarks();
+
+}  // namespace microbench
+
+#define MICROBENCH_CONCAT_(a, b) a##b
+#define MICROBENCH_CONCAT(a, b) MICROBENCH_CONCAT_(a, b)
+
+#define MICROBENCH(function)                                          \
+  static ::microbench::Benchmark *MICROBENCH_CONCAT(                  \
+      microbench_registration_, __LINE__) __attribute__((unused)) = \
+      ::microbench::RegisterBenchmark(#function, function)
+
+#define MICROBENCH_MAIN()                                      \
+  int main(int argc, char **argv) {                            \
+    if (!::microbench::Initialize(&argc, argv)) {              \
+      return 1;                                                \
+    }                                                          \
+    ::microbench::RunSpecifiedBenchmarks();                    \
+    return 0;                                                  \
+  }
+
+#endif  // MICROBENCH_MICROBENCH_H_
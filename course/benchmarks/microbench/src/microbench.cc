@@ -0,0 +1,292 @@
+// Copyright 2020, Ekumen
+//
+// microbench: a small micro-benchmark harness modelled after Google
+// Benchmark.
+
+#include "microbench/microbench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace microbench {
+
+namespace {
+
+struct Flags {
+  std::string filter{"."};
+  double min_time{0.5};
+  std::string out;
+  bool list_tests{false};
+};
+
+Flags &flags() {
+  static Flags instance;
+  return instance;
+}
+
+std::vector<std::unique_ptr<Benchmark>> &registry() {
+  static std::vector<std::unique_ptr<Benchmark>> instance;
+  return instance;
+}
+
+struct Run {
+  std::string name;
+  std::int64_t iterations;
+  double real_time_ns;
+  double cpu_time_ns;
+  double items_per_second;
+};
+
+std::string runName(const Benchmark &benchmark,
+                    const std::vector<std::int64_t> &args) {
+  std::string name{benchmark.name()};
+  for (const std::int64_t arg : args) {
+    name += '/';
+    name += std::to_string(arg);
+  }
+  return name;
+}
+
+Run runOnce(const Benchmark &benchmark, const std::vector<std::int64_t> &args,
+            const std::int64_t iterations) {
+  State state{iterations, args};
+  benchmark.function()(state);
+  Run run;
+  run.name = runName(benchmark, args);
+  run.iterations = iterations;
+  run.real_time_ns = state.real_time_seconds() * 1e9 / iterations;
+  run.cpu_time_ns = state.cpu_time_seconds() * 1e9 / iterations;
+  run.items_per_second =
+      state.real_time_seconds() > 0.
+          ? static_cast<double>(state.items_processed()) /
+                state.real_time_seconds()
+          : 0.;
+  return run;
+}
+
+// Grows the number of iterations until a run lasts at least the minimum time,
+// the same way Google Benchmark does.
+Run runBenchmark(const Benchmark &benchmark,
+                 const std::vector<std::int64_t> &args) {
+  const std::int64_t kMaxIterations{1000000000};
+  std::int64_t iterations{1};
+  while (true) {
+    const Run run{runOnce(benchmark, args, iterations)};
+    const double seconds{run.real_time_ns * iterations * 1e-9};
+    if ((seconds >= flags().min_time) || (iterations >= kMaxIterations)) {
+      return run;
+    }
+    double multiplier{seconds > 0. ? flags().min_time * 1.4 / seconds : 10.};
+    multiplier = std::min(std::max(multiplier, 2.), 10.);
+    iterations = std::min(kMaxIterations,
+                          static_cast<std::int64_t>(
+                              static_cast<double>(iterations) * multiplier));
+  }
+}
+
+std::string jsonEscape(const std::string &text) {
+  std::string escaped;
+  for (const char c : text) {
+    if ((c == '"') || (c == '\\')) {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+std::string currentDate() {
+  const std::time_t now{std::time(nullptr)};
+  char buffer[64];
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S%z",
+                std::localtime(&now));
+  return buffer;
+}
+
+void writeJson(std::ostream &os, const std::vector<Run> &runs) {
+  os << "{\n";
+  os << "  \"context\": {\n";
+  os << "    \"date\": \"" << currentDate() << "\",\n";
+  os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+  os << "    \"library_build_type\": \"release\"\n";
+#else
+  os << "    \"library_build_type\": \"debug\"\n";
+#endif
+  os << "  },\n";
+  os << "  \"benchmarks\": [";
+  os << std::setprecision(10);
+  for (std::size_t i = 0; i < runs.size(); ++i) {
+    const Run &run{runs[i]};
+    os << (i > 0 ? ",\n" : "\n");
+    os << "    {\n";
+    os << "      \"name\": \"" << jsonEscape(run.name) << "\",\n";
+    os << "      \"run_name\": \"" << jsonEscape(run.name) << "\",\n";
+    os << "      \"run_type\": \"iteration\",\n";
+    os << "      \"iterations\": " << run.iterations << ",\n";
+    os << "      \"real_time\": " << run.real_time_ns << ",\n";
+    os << "      \"cpu_time\": " << run.cpu_time_ns << ",\n";
+    os << "      \"time_unit\": \"ns\"";
+    if (run.items_per_second > 0.) {
+      os << ",\n      \"items_per_second\": " << run.items_per_second;
+    }
+    os << "\n    }";
+  }
+  os << "\n  ]\n";
+  os << "}\n";
+}
+
+void printHeader() {
+  std::printf("%-48s %15s %15s %12s %15s\n", "Benchmark", "Time (ns)",
+              "CPU (ns)", "Iterations", "ns/item");
+  std::printf("%s\n", std::string(109, '-').c_str());
+}
+
+void printRun(const Run &run) {
+  const double ns_per_item{run.items_per_second > 0.
+                               ? 1e9 / run.items_per_second
+                               : run.real_time_ns};
+  std::printf("%-48s %15.2f %15.2f %12lld %15.3f\n", run.name.c_str(),
+              run.real_time_ns, run.cpu_time_ns,
+              static_cast<long long>(run.iterations), ns_per_item);
+}
+
+bool parseFlag(const char *arg, const char *flag, std::string *value) {
+  const std::size_t length{std::strlen(flag)};
+  if ((std::strncmp(arg, flag, length) != 0) || (arg[length] != '=')) {
+    return false;
+  }
+  *value = arg + length + 1;
+  return true;
+}
+
+}  // namespace
+
+State::State(std::int64_t max_iterations, std::vector<std::int64_t> ranges)
+    : max_iterations_{max_iterations},
+      ranges_{std::move(ranges)},
+      iterations_left_{max_iterations} {}
+
+bool State::KeepRunning() {
+  if (!started_) {
+    started_ = true;
+    StartTimer();
+  }
+  if (iterations_left_ > 0) {
+    --iterations_left_;
+    return true;
+  }
+  if (running_) {
+    StopTimer();
+  }
+  return false;
+}
+
+std::int64_t State::range(std::size_t index) const {
+  if (index >= ranges_.size()) {
+    throw std::out_of_range("Benchmark argument index out of range");
+  }
+  return ranges_[index];
+}
+
+void State::PauseTiming() { StopTimer(); }
+
+void State::ResumeTiming() { StartTimer(); }
+
+void State::StartTimer() {
+  running_ = true;
+  real_start_ = std::chrono::steady_clock::now();
+  cpu_start_ = std::clock();
+}
+
+void State::StopTimer() {
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() -
+                                              real_start_};
+  real_time_ += elapsed.count();
+  cpu_time_ += static_cast<double>(std::clock() - cpu_start_) / CLOCKS_PER_SEC;
+  running_ = false;
+}
+
+Benchmark::Benchmark(const std::string &name, Function function)
+    : name_{name}, function_{function} {}
+
+Benchmark *Benchmark::Arg(std::int64_t arg) { return Args({arg}); }
+
+Benchmark *Benchmark::Args(const std::vector<std::int64_t> &args) {
+  args_.push_back(args);
+  return this;
+}
+
+Benchmark *RegisterBenchmark(const std::string &name, Function function) {
+  registry().emplace_back(new Benchmark{name, function});
+  return registry().back().get();
+}
+
+bool Initialize(int *argc, char **argv) {
+  int remaining{1};
+  for (int i = 1; i < *argc; ++i) {
+    std::string value;
+    if (parseFlag(argv[i], "--benchmark_filter", &value)) {
+      flags().filter = value;
+    } else if (parseFlag(argv[i], "--benchmark_min_time", &value)) {
+      flags().min_time = std::stod(value);
+    } else if (parseFlag(argv[i], "--benchmark_out", &value)) {
+      flags().out = value;
+    } else if (std::strcmp(argv[i], "--benchmark_list_tests") == 0) {
+      flags().list_tests = true;
+    } else if (std::strncmp(argv[i], "--benchmark_", 12) == 0) {
+      std::cerr << "Unrecognized flag: " << argv[i] << std::endl;
+      return false;
+    } else {
+      argv[remaining++] = argv[i];
+    }
+  }
+  *argc = remaining;
+  return true;
+}
+
+std::size_t RunSpecifiedBenchmarks() {
+  const std::regex filter{flags().filter};
+  std::vector<Run> runs;
+  if (!flags().list_tests) {
+    printHeader();
+  }
+  for (const std::unique_ptr<Benchmark> &benchmark : registry()) {
+    std::vector<std::vector<std::int64_t>> arg_sets{benchmark->args()};
+    if (arg_sets.empty()) {
+      arg_sets.emplace_back();
+    }
+    for (const std::vector<std::int64_t> &args : arg_sets) {
+      const std::string name{runName(*benchmark, args)};
+      if (!std::regex_search(name, filter)) {
+        continue;
+      }
+      if (flags().list_tests) {
+        std::cout << name << std::endl;
+        continue;
+      }
+      runs.push_back(runBenchmark(*benchmark, args));
+      printRun(runs.back());
+    }
+  }
+  if (!flags().out.empty()) {
+    std::ofstream out{flags().out};
+    if (!out) {
+      std::cerr << "Could not open " << flags().out << std::endl;
+    } else {
+      writeJson(out, runs);
+    }
+  }
+  return runs.size();
+}
+
+}  // namespace microbench
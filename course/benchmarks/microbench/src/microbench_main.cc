@@ -0,0 +1,7 @@
+// Copyright 2020, Ekumen
+//
+// Default entry point for benchmark executables.
+
+#include "microbench/microbench.h"
+
+MICROBENCH_MAIN();
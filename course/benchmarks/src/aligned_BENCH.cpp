@@ -0,0 +1,64 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <vector>
+
+#include <isometry/aligned.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+// Padded counterparts of the BM_Matrix3Product and BM_Matrix3VectorProduct
+// figures in matrix3_BENCH.cpp.
+
+std::vector<AlignedMatrix3> randomAlignedMatrices(const std::size_t n) {
+  std::vector<AlignedMatrix3> result;
+  result.reserve(n);
+  for (const Matrix3 &m : randomMatrices(n)) {
+    result.emplace_back(m);
+  }
+  return result;
+}
+
+std::vector<AlignedVector3> randomAlignedVectors(const std::size_t n) {
+  std::vector<AlignedVector3> result;
+  result.reserve(n);
+  for (const Vector3 &v : randomVectors(n)) {
+    result.emplace_back(v);
+  }
+  return result;
+}
+
+void BM_AlignedMatrix3Product(microbench::State &state) {
+  const std::vector<AlignedMatrix3> a{randomAlignedMatrices(batchSize(state))};
+  const std::vector<AlignedMatrix3> b{randomAlignedMatrices(batchSize(state))};
+  std::vector<AlignedMatrix3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].product(b[i]); });
+}
+ISOMETRY_BENCHMARK(BM_AlignedMatrix3Product);
+
+void BM_AlignedMatrix3VectorProduct(microbench::State &state) {
+  const std::vector<AlignedMatrix3> a{randomAlignedMatrices(batchSize(state))};
+  const std::vector<AlignedVector3> v{randomAlignedVectors(batchSize(state))};
+  std::vector<AlignedVector3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * v[i]; });
+}
+ISOMETRY_BENCHMARK(BM_AlignedMatrix3VectorProduct);
+
+void BM_AlignedVector3RoundTrip(microbench::State &state) {
+  const std::vector<Vector3> v{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(v.size());
+  runBatch(state, out,
+           [&](std::size_t i) { return AlignedVector3{v[i]}.compact(); });
+}
+ISOMETRY_BENCHMARK(BM_AlignedVector3RoundTrip);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,121 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <isometry/frame_graph.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+// A planning cycle that creates as many candidate trajectories, pose and
+// point vectors, as the batch size, and drops them all at the end. With an
+// arena the whole cycle is released at once, back to a buffer that is
+// allocated once up front.
+constexpr std::size_t kPosesPerTrajectory{32};
+
+struct Trajectory {
+  explicit Trajectory(std::pmr::memory_resource *resource)
+      : poses{resource}, points{resource} {
+    poses.reserve(kPosesPerTrajectory);
+    points.reserve(kPosesPerTrajectory);
+  }
+
+  std::pmr::vector<Isometry> poses;
+  std::pmr::vector<Vector3> points;
+};
+
+void planningCycle(const std::size_t trajectories,
+                   std::pmr::memory_resource *resource, const Isometry &pose,
+                   const Vector3 &point) {
+  std::pmr::vector<Trajectory> candidates{resource};
+  candidates.reserve(trajectories);
+  for (std::size_t i = 0; i < trajectories; ++i) {
+    Trajectory &trajectory{candidates.emplace_back(resource)};
+    for (std::size_t j = 0; j < kPosesPerTrajectory; ++j) {
+      trajectory.poses.push_back(pose);
+      trajectory.points.push_back(point);
+    }
+  }
+  microbench::DoNotOptimize(candidates.data());
+}
+
+std::size_t cycleBytes(const std::size_t trajectories) {
+  return trajectories *
+         (sizeof(Trajectory) +
+          kPosesPerTrajectory * (sizeof(Isometry) + sizeof(Vector3)) + 64);
+}
+
+void BM_PlanningCycleDefaultResource(microbench::State &state) {
+  const Isometry pose{randomIsometries(1).front()};
+  const Vector3 point{randomVectors(1).front()};
+  while (state.KeepRunning()) {
+    planningCycle(batchSize(state), std::pmr::get_default_resource(), pose,
+                  point);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(batchSize(state)));
+}
+ISOMETRY_BENCHMARK(BM_PlanningCycleDefaultResource);
+
+void BM_PlanningCycleMonotonicArena(microbench::State &state) {
+  const Isometry pose{randomIsometries(1).front()};
+  const Vector3 point{randomVectors(1).front()};
+  std::vector<std::byte> buffer(cycleBytes(batchSize(state)));
+  std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size()};
+  while (state.KeepRunning()) {
+    planningCycle(batchSize(state), &arena, pose, point);
+    arena.release();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(batchSize(state)));
+}
+ISOMETRY_BENCHMARK(BM_PlanningCycleMonotonicArena);
+
+// Builds and drops a frame graph with as many frames as the batch size.
+void buildGraph(const std::size_t frames,
+                std::pmr::memory_resource *resource, const Isometry &edge) {
+  FrameGraph graph{"planner_root_frame", resource};
+  std::string name{"planner_frame_"};
+  for (std::size_t i = 0; i < frames; ++i) {
+    name.resize(14);
+    name += std::to_string(i);
+    graph.addFrame(name, graph.size() - 1, edge);
+  }
+  microbench::DoNotOptimize(&graph);
+}
+
+void BM_FrameGraphBuildDefaultResource(microbench::State &state) {
+  const Isometry edge{randomIsometries(1).front()};
+  while (state.KeepRunning()) {
+    buildGraph(batchSize(state), std::pmr::get_default_resource(), edge);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(batchSize(state)));
+}
+ISOMETRY_BENCHMARK(BM_FrameGraphBuildDefaultResource);
+
+void BM_FrameGraphBuildMonotonicArena(microbench::State &state) {
+  const Isometry edge{randomIsometries(1).front()};
+  std::pmr::monotonic_buffer_resource arena;
+  while (state.KeepRunning()) {
+    buildGraph(batchSize(state), &arena, edge);
+    arena.release();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(batchSize(state)));
+}
+ISOMETRY_BENCHMARK(BM_FrameGraphBuildMonotonicArena);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
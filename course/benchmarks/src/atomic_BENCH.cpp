@@ -0,0 +1,55 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <atomic>
+#include <thread>
+
+#include <isometry/atomic.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+void BM_AtomicIsometryStore(microbench::State &state) {
+  AtomicIsometry published;
+  const Isometry isometry{randomIsometries(1).front()};
+  while (state.KeepRunning()) {
+    published.store(isometry);
+  }
+}
+MICROBENCH(BM_AtomicIsometryStore);
+
+void BM_AtomicIsometryLoad(microbench::State &state) {
+  const AtomicIsometry published{randomIsometries(1).front()};
+  while (state.KeepRunning()) {
+    microbench::DoNotOptimize(published.load());
+  }
+}
+MICROBENCH(BM_AtomicIsometryLoad);
+
+// Loads while another thread keeps storing new values.
+void BM_AtomicIsometryLoadWhileStoring(microbench::State &state) {
+  AtomicIsometry published{randomIsometries(1).front()};
+  std::atomic<bool> done{false};
+  std::thread writer([&]() {
+    const Isometry isometry{published.load()};
+    while (!done.load(std::memory_order_relaxed)) {
+      published.store(isometry);
+    }
+  });
+  while (state.KeepRunning()) {
+    microbench::DoNotOptimize(published.load());
+  }
+  done.store(true, std::memory_order_relaxed);
+  writer.join();
+}
+MICROBENCH(BM_AtomicIsometryLoadWhileStoring);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
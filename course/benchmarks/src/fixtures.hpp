@@ -0,0 +1,98 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ *
+ * Shared input generators and helpers for the library benchmarks.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <isometry/isometry.hpp>
+#include "microbench/microbench.h"
+
+// Every operation is measured over batches of a few different sizes, so
+// that both the per-call overhead and the steady-state throughput show up.
+#define ISOMETRY_BENCHMARK(function) \
+  MICROBENCH(function)->Arg(1)->Arg(64)->Arg(4096)
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+
+inline std::size_t batchSize(const microbench::State &state) {
+  return static_cast<std::size_t>(state.range(0));
+}
+
+inline std::mt19937 &generator() {
+  static std::mt19937 instance{1234};
+  return instance;
+}
+
+inline double randomScalar(const double min = -10., const double max = 10.) {
+  return std::uniform_real_distribution<double>{min, max}(generator());
+}
+
+inline std::vector<double> randomScalars(const std::size_t n,
+                                         const double min = -10.,
+                                         const double max = 10.) {
+  std::vector<double> result(n);
+  for (double &value : result) {
+    value = randomScalar(min, max);
+  }
+  return result;
+}
+
+inline std::vector<Vector3> randomVectors(const std::size_t n) {
+  std::vector<Vector3> result(n);
+  for (Vector3 &value : result) {
+    value = Vector3{randomScalar(), randomScalar(), randomScalar()};
+  }
+  return result;
+}
+
+inline std::vector<Matrix3> randomMatrices(const std::size_t n) {
+  std::vector<Matrix3> result(n);
+  for (Matrix3 &value : result) {
+    value = Matrix3{randomScalar(), randomScalar(), randomScalar(),
+                    randomScalar(), randomScalar(), randomScalar(),
+                    randomScalar(), randomScalar(), randomScalar()};
+  }
+  return result;
+}
+
+inline std::vector<Isometry> randomIsometries(const std::size_t n) {
+  std::vector<Isometry> result(n);
+  for (Isometry &value : result) {
+    const Isometry rotation{Isometry::fromEulerAngles(
+        randomScalar(-M_PI, M_PI), randomScalar(-M_PI, M_PI),
+        randomScalar(-M_PI, M_PI))};
+    value = Isometry{
+        Vector3{randomScalar(), randomScalar(), randomScalar()},
+        rotation.rotation()};
+  }
+  return result;
+}
+
+// Evaluates |operation| for every index of |output| on each iteration, and
+// reports one processed item per evaluation.
+template <typename Output, typename Operation>
+void runBatch(microbench::State &state, std::vector<Output> &output,
+              Operation operation) {
+  const std::size_t n{output.size()};
+  while (state.KeepRunning()) {
+    for (std::size_t i = 0; i < n; ++i) {
+      output[i] = operation(i);
+    }
+    microbench::DoNotOptimize(output.data());
+    microbench::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,71 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <string>
+#include <vector>
+
+#include <isometry/frame_graph.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+// Builds a chain of |depth| frames under the root and returns the id of the
+// deepest one.
+FrameGraph::FrameId buildChain(FrameGraph &graph, const std::size_t depth) {
+  FrameGraph::FrameId parent{FrameGraph::kRootId};
+  for (const Isometry &edge : randomIsometries(depth)) {
+    parent = graph.addFrame("frame_" + std::to_string(graph.size()), parent,
+                            edge);
+  }
+  return parent;
+}
+
+// Repeated queries hit the cache.
+void BM_FrameGraphCachedRootTransform(microbench::State &state) {
+  FrameGraph graph{"root"};
+  const FrameGraph::FrameId leaf{buildChain(graph, batchSize(state))};
+  while (state.KeepRunning()) {
+    microbench::DoNotOptimize(&graph.rootTransform(leaf));
+  }
+}
+ISOMETRY_BENCHMARK(BM_FrameGraphCachedRootTransform);
+
+// Updates the edge right under the root before each query, so the whole
+// chain is composed again.
+void BM_FrameGraphUpdateAndRootTransform(microbench::State &state) {
+  FrameGraph graph{"root"};
+  const FrameGraph::FrameId leaf{buildChain(graph, batchSize(state))};
+  const Isometry edge{graph.parentTransform(1)};
+  while (state.KeepRunning()) {
+    graph.setTransform(1, edge);
+    microbench::DoNotOptimize(&graph.rootTransform(leaf));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(batchSize(state)));
+}
+ISOMETRY_BENCHMARK(BM_FrameGraphUpdateAndRootTransform);
+
+// Updates a leaf edge before querying between two leaves of distinct
+// branches, which only recomposes the updated leaf.
+void BM_FrameGraphUpdateLeafAndRelativeTransform(microbench::State &state) {
+  FrameGraph graph{"root"};
+  const FrameGraph::FrameId leaf{buildChain(graph, batchSize(state))};
+  const FrameGraph::FrameId other{graph.addFrame(
+      "other", graph.parent(leaf), randomIsometries(1).front())};
+  const Isometry edge{graph.parentTransform(leaf)};
+  while (state.KeepRunning()) {
+    graph.setTransform(leaf, edge);
+    microbench::DoNotOptimize(graph.relativeTransform(other, leaf));
+  }
+}
+ISOMETRY_BENCHMARK(BM_FrameGraphUpdateLeafAndRelativeTransform);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
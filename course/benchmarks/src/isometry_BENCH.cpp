@@ -0,0 +1,343 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include <isometry/accumulated_isometry.hpp>
+#include <isometry/kernels.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+void BM_IsometryFromTranslation(microbench::State &state) {
+  const std::vector<Vector3> v{randomVectors(batchSize(state))};
+  std::vector<Isometry> out(v.size());
+  runBatch(state, out,
+           [&](std::size_t i) { return Isometry::fromTranslation(v[i]); });
+}
+ISOMETRY_BENCHMARK(BM_IsometryFromTranslation);
+
+void BM_IsometryRotateAround(microbench::State &state) {
+  const std::vector<Vector3> axes{randomVectors(batchSize(state))};
+  const std::vector<double> angles{randomScalars(batchSize(state))};
+  std::vector<Isometry> out(axes.size());
+  runBatch(state, out, [&](std::size_t i) {
+    return Isometry::rotateAround(axes[i], angles[i]);
+  });
+}
+ISOMETRY_BENCHMARK(BM_IsometryRotateAround);
+
+void BM_IsometryFromEulerAngles(microbench::State &state) {
+  const std::vector<double> roll{randomScalars(batchSize(state))};
+  const std::vector<double> pitch{randomScalars(batchSize(state))};
+  const std::vector<double> yaw{randomScalars(batchSize(state))};
+  std::vector<Isometry> out(roll.size());
+  runBatch(state, out, [&](std::size_t i) {
+    return Isometry::fromEulerAngles(roll[i], pitch[i], yaw[i]);
+  });
+}
+ISOMETRY_BENCHMARK(BM_IsometryFromEulerAngles);
+
+void BM_IsometryFromEulerAnglesZYZ(microbench::State &state) {
+  const std::vector<double> first{randomScalars(batchSize(state))};
+  const std::vector<double> second{randomScalars(batchSize(state))};
+  const std::vector<double> third{randomScalars(batchSize(state))};
+  std::vector<Isometry> out(first.size());
+  runBatch(state, out, [&](std::size_t i) {
+    return Isometry::fromEulerAngles<EulerConvention::kIntrinsicZYZ>(
+        first[i], second[i], third[i]);
+  });
+}
+ISOMETRY_BENCHMARK(BM_IsometryFromEulerAnglesZYZ);
+
+void BM_IsometryToEulerAngles(microbench::State &state) {
+  const std::vector<Isometry> isometries{randomIsometries(batchSize(state))};
+  std::vector<std::array<double, 3>> out(isometries.size());
+  runBatch(state, out,
+           [&](std::size_t i) { return isometries[i].toEulerAngles(); });
+}
+ISOMETRY_BENCHMARK(BM_IsometryToEulerAngles);
+
+void BM_StdSinCos(microbench::State &state) {
+  const std::vector<double> angles{randomScalars(batchSize(state))};
+  std::vector<double> sines(angles.size()), cosines(angles.size());
+  while (state.KeepRunning()) {
+    for (std::size_t i = 0; i < angles.size(); ++i) {
+      sines[i] = std::sin(angles[i]);
+      cosines[i] = std::cos(angles[i]);
+    }
+    microbench::DoNotOptimize(sines.data());
+    microbench::DoNotOptimize(cosines.data());
+    microbench::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(angles.size()));
+}
+ISOMETRY_BENCHMARK(BM_StdSinCos);
+
+void BM_SinCosKernel(microbench::State &state) {
+  const std::vector<double> angles{randomScalars(batchSize(state))};
+  std::vector<double> sines(angles.size()), cosines(angles.size());
+  const kernels::SinCosKernel sincos{kernels::activeKernels().sincos};
+  while (state.KeepRunning()) {
+    sincos(angles.data(), angles.size(), sines.data(), cosines.data());
+    microbench::DoNotOptimize(sines.data());
+    microbench::DoNotOptimize(cosines.data());
+    microbench::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(angles.size()));
+}
+ISOMETRY_BENCHMARK(BM_SinCosKernel);
+
+// Batch constructors, which take their sines and cosines from the
+// vectorized kernel.
+void BM_IsometryRotateAroundBatch(microbench::State &state) {
+  const Vector3 axis{randomVectors(1).front()};
+  const std::vector<double> angles{randomScalars(batchSize(state))};
+  std::vector<Isometry> out(angles.size());
+  while (state.KeepRunning()) {
+    Isometry::rotateAround(axis, angles, out);
+    microbench::DoNotOptimize(out.data());
+    microbench::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(angles.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryRotateAroundBatch);
+
+void BM_IsometryFromEulerAnglesBatch(microbench::State &state) {
+  const std::vector<double> roll{randomScalars(batchSize(state))};
+  const std::vector<double> pitch{randomScalars(batchSize(state))};
+  const std::vector<double> yaw{randomScalars(batchSize(state))};
+  std::vector<Isometry> out(roll.size());
+  while (state.KeepRunning()) {
+    Isometry::fromEulerAngles(roll, pitch, yaw, out);
+    microbench::DoNotOptimize(out.data());
+    microbench::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(roll.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryFromEulerAnglesBatch);
+
+void BM_IsometryCompose(microbench::State &state) {
+  const std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  const std::vector<Isometry> b{randomIsometries(batchSize(state))};
+  std::vector<Isometry> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].compose(b[i]); });
+}
+ISOMETRY_BENCHMARK(BM_IsometryCompose);
+
+void BM_IsometryCompoundCompose(microbench::State &state) {
+  const std::vector<Isometry> b{randomIsometries(batchSize(state))};
+  std::vector<Isometry> out{randomIsometries(batchSize(state))};
+  runBatch(state, out, [&](std::size_t i) { return out[i] *= b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_IsometryCompoundCompose);
+
+void BM_IsometryInverse(microbench::State &state) {
+  const std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  std::vector<Isometry> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].inverse(); });
+}
+ISOMETRY_BENCHMARK(BM_IsometryInverse);
+
+void BM_IsometryRigidInverse(microbench::State &state) {
+  const std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  std::vector<Isometry> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].rigidInverse(); });
+}
+ISOMETRY_BENCHMARK(BM_IsometryRigidInverse);
+
+// Rotations drifted by long chains of compositions, which take a single
+// correction step.
+void BM_IsometryOrthonormalized(microbench::State &state) {
+  std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  const Isometry delta{randomIsometries(1).front()};
+  for (Isometry &isometry : a) {
+    for (int i = 0; i < 1000; ++i) {
+      isometry *= delta;
+    }
+  }
+  std::vector<Isometry> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].orthonormalized(); });
+}
+ISOMETRY_BENCHMARK(BM_IsometryOrthonormalized);
+
+// Integrators accumulating compositions, with and without the periodic
+// re-orthonormalization.
+void BM_IsometryAccumulate(microbench::State &state) {
+  const std::vector<Isometry> deltas{randomIsometries(batchSize(state))};
+  Isometry pose{Isometry::fromTranslation(Vector3::kZero)};
+  while (state.KeepRunning()) {
+    for (const Isometry &delta : deltas) {
+      pose *= delta;
+    }
+    microbench::DoNotOptimize(&pose);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(deltas.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryAccumulate);
+
+void BM_AccumulatedIsometryAccumulate(microbench::State &state) {
+  const std::vector<Isometry> deltas{randomIsometries(batchSize(state))};
+  AccumulatedIsometry pose;
+  while (state.KeepRunning()) {
+    for (const Isometry &delta : deltas) {
+      pose *= delta;
+    }
+    microbench::DoNotOptimize(&pose);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(deltas.size()));
+}
+ISOMETRY_BENCHMARK(BM_AccumulatedIsometryAccumulate);
+
+// Twists with rotations of up to about pi, or with the small rotations of
+// integrator steps, which take the Taylor series.
+std::vector<Twist> randomTwists(const std::size_t n, const double max_angle) {
+  const double max_component{max_angle / std::sqrt(3.)};
+  std::vector<Twist> result(n);
+  for (Twist &twist : result) {
+    twist = Twist{Vector3{randomScalar(), randomScalar(), randomScalar()},
+                  Vector3{randomScalar(-max_component, max_component),
+                          randomScalar(-max_component, max_component),
+                          randomScalar(-max_component, max_component)}};
+  }
+  return result;
+}
+
+void BM_IsometryExp(microbench::State &state) {
+  const std::vector<Twist> twists{randomTwists(batchSize(state), M_PI)};
+  std::vector<Isometry> out(twists.size());
+  runBatch(state, out, [&](std::size_t i) { return Isometry::exp(twists[i]); });
+}
+ISOMETRY_BENCHMARK(BM_IsometryExp);
+
+void BM_IsometryExpSmallAngle(microbench::State &state) {
+  const std::vector<Twist> twists{randomTwists(batchSize(state), 1e-3)};
+  std::vector<Isometry> out(twists.size());
+  runBatch(state, out, [&](std::size_t i) { return Isometry::exp(twists[i]); });
+}
+ISOMETRY_BENCHMARK(BM_IsometryExpSmallAngle);
+
+void BM_IsometryExpBatch(microbench::State &state) {
+  const std::vector<Twist> twists{randomTwists(batchSize(state), M_PI)};
+  std::vector<Isometry> out(twists.size());
+  while (state.KeepRunning()) {
+    Isometry::exp(twists, out);
+    microbench::DoNotOptimize(out.data());
+    microbench::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(twists.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryExpBatch);
+
+void BM_IsometryLog(microbench::State &state) {
+  const std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  std::vector<Twist> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].log(); });
+}
+ISOMETRY_BENCHMARK(BM_IsometryLog);
+
+void BM_IsometryLogSmallAngle(microbench::State &state) {
+  std::vector<Isometry> a(batchSize(state));
+  Isometry::exp(randomTwists(a.size(), 1e-3), a);
+  std::vector<Twist> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].log(); });
+}
+ISOMETRY_BENCHMARK(BM_IsometryLogSmallAngle);
+
+void BM_IsometryInverseThenTransform(microbench::State &state) {
+  const std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  const std::vector<Vector3> v{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].inverse() * v[i]; });
+}
+ISOMETRY_BENCHMARK(BM_IsometryInverseThenTransform);
+
+void BM_IsometryInverseTransform(microbench::State &state) {
+  const std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  const std::vector<Vector3> v{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(a.size());
+  runBatch(state, out,
+           [&](std::size_t i) { return a[i].inverseTransform(v[i]); });
+}
+ISOMETRY_BENCHMARK(BM_IsometryInverseTransform);
+
+void BM_IsometryTransform(microbench::State &state) {
+  const std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  const std::vector<Vector3> v{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * v[i]; });
+}
+ISOMETRY_BENCHMARK(BM_IsometryTransform);
+
+void BM_IsometryEqual(microbench::State &state) {
+  const std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  const std::vector<Isometry> b{a};
+  std::vector<char> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] == b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_IsometryEqual);
+
+void BM_IsometryStream(microbench::State &state) {
+  const std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  std::vector<std::string> out(a.size());
+  runBatch(state, out, [&](std::size_t i) {
+    std::ostringstream os;
+    os << a[i];
+    return os.str();
+  });
+}
+ISOMETRY_BENCHMARK(BM_IsometryStream);
+
+// Pushes a whole point batch through one isometry per iteration.
+void BM_IsometryBatchTransform(microbench::State &state) {
+  const Isometry t{randomIsometries(1).front()};
+  Vector3Batch input;
+  for (const Vector3 &point : randomVectors(batchSize(state))) {
+    input.push_back(point);
+  }
+  Vector3Batch output;
+  while (state.KeepRunning()) {
+    t.transform(input, output);
+    microbench::DoNotOptimize(output.x());
+    microbench::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(input.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryBatchTransform);
+
+void BM_IsometryBatchTransformInPlace(microbench::State &state) {
+  const Isometry t{randomIsometries(1).front()};
+  Vector3Batch points;
+  for (const Vector3 &point : randomVectors(batchSize(state))) {
+    points.push_back(point);
+  }
+  while (state.KeepRunning()) {
+    t.transform(points);
+    microbench::DoNotOptimize(points.x());
+    microbench::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(points.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryBatchTransformInPlace);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
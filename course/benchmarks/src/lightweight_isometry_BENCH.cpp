@@ -0,0 +1,107 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ *
+ * Compositions of the lightweight isometry types, next to the full isometry
+ * compositions they replace.
+ */
+
+#include <vector>
+
+#include <isometry/lightweight_isometry.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+std::vector<Translation3> randomTranslations(const std::size_t n) {
+  std::vector<Translation3> result;
+  for (const Vector3 &v : randomVectors(n)) {
+    result.emplace_back(v);
+  }
+  return result;
+}
+
+std::vector<PlanarIsometry> randomPlanarIsometries(const std::size_t n) {
+  std::vector<PlanarIsometry> result;
+  for (std::size_t i = 0; i < n; ++i) {
+    result.emplace_back(randomScalar(), randomScalar(),
+                        randomScalar(-M_PI, M_PI));
+  }
+  return result;
+}
+
+void BM_Translation3Compose(microbench::State &state) {
+  const std::vector<Translation3> a{randomTranslations(batchSize(state))};
+  const std::vector<Translation3> b{randomTranslations(batchSize(state))};
+  std::vector<Translation3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Translation3Compose);
+
+void BM_IsometryTranslationCompose(microbench::State &state) {
+  std::vector<Isometry> a, b;
+  for (const Vector3 &v : randomVectors(batchSize(state))) {
+    a.push_back(Isometry::fromTranslation(v));
+  }
+  for (const Vector3 &v : randomVectors(batchSize(state))) {
+    b.push_back(Isometry::fromTranslation(v));
+  }
+  std::vector<Isometry> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_IsometryTranslationCompose);
+
+void BM_AxisRotationCompose(microbench::State &state) {
+  std::vector<AxisRotation<Axis::kZ>> a, b;
+  for (const double angle : randomScalars(batchSize(state))) {
+    a.emplace_back(angle);
+  }
+  for (const double angle : randomScalars(batchSize(state))) {
+    b.emplace_back(angle);
+  }
+  std::vector<AxisRotation<Axis::kZ>> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_AxisRotationCompose);
+
+void BM_PlanarIsometryCompose(microbench::State &state) {
+  const std::vector<PlanarIsometry> a{
+      randomPlanarIsometries(batchSize(state))};
+  const std::vector<PlanarIsometry> b{
+      randomPlanarIsometries(batchSize(state))};
+  std::vector<PlanarIsometry> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_PlanarIsometryCompose);
+
+void BM_IsometryPlanarCompose(microbench::State &state) {
+  std::vector<Isometry> a, b;
+  for (const PlanarIsometry &p : randomPlanarIsometries(batchSize(state))) {
+    a.push_back(p);
+  }
+  for (const PlanarIsometry &p : randomPlanarIsometries(batchSize(state))) {
+    b.push_back(p);
+  }
+  std::vector<Isometry> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_IsometryPlanarCompose);
+
+void BM_IsometryComposeAxisRotation(microbench::State &state) {
+  const std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  std::vector<AxisRotation<Axis::kZ>> b;
+  for (const double angle : randomScalars(batchSize(state))) {
+    b.emplace_back(angle);
+  }
+  std::vector<Isometry> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_IsometryComposeAxisRotation);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
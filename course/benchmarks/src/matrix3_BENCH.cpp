@@ -0,0 +1,160 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <sstream>
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+void BM_Matrix3Construct(microbench::State &state) {
+  const std::vector<double> s{randomScalars(batchSize(state))};
+  std::vector<Matrix3> out(s.size());
+  runBatch(state, out, [&](std::size_t i) {
+    return Matrix3{s[i], s[i], s[i], s[i], s[i], s[i], s[i], s[i], s[i]};
+  });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3Construct);
+
+void BM_Matrix3Add(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  const std::vector<Matrix3> b{randomMatrices(batchSize(state))};
+  std::vector<Matrix3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] + b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3Add);
+
+void BM_Matrix3Subtract(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  const std::vector<Matrix3> b{randomMatrices(batchSize(state))};
+  std::vector<Matrix3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] - b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3Subtract);
+
+void BM_Matrix3ElementwiseMultiply(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  const std::vector<Matrix3> b{randomMatrices(batchSize(state))};
+  std::vector<Matrix3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3ElementwiseMultiply);
+
+void BM_Matrix3ElementwiseDivide(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  const std::vector<Matrix3> b{randomMatrices(batchSize(state))};
+  std::vector<Matrix3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] / b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3ElementwiseDivide);
+
+void BM_Matrix3ScalarMultiply(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  const std::vector<double> s{randomScalars(batchSize(state))};
+  std::vector<Matrix3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return s[i] * a[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3ScalarMultiply);
+
+void BM_Matrix3ChainedExpression(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  const std::vector<Matrix3> b{randomMatrices(batchSize(state))};
+  const std::vector<Matrix3> c{randomMatrices(batchSize(state))};
+  std::vector<Matrix3> out(a.size());
+  runBatch(state, out,
+           [&](std::size_t i) { return 2. * b[i] + c[i] - a[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3ChainedExpression);
+
+void BM_Matrix3Product(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  const std::vector<Matrix3> b{randomMatrices(batchSize(state))};
+  std::vector<Matrix3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].product(b[i]); });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3Product);
+
+void BM_Matrix3VectorProduct(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  const std::vector<Vector3> v{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * v[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3VectorProduct);
+
+void BM_Matrix3Det(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  std::vector<double> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].det(); });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3Det);
+
+void BM_Matrix3OrthonormalityError(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  std::vector<double> out(a.size());
+  runBatch(state, out,
+           [&](std::size_t i) { return a[i].orthonormalityError(); });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3OrthonormalityError);
+
+void BM_Matrix3Transpose(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  std::vector<Matrix3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].transpose(); });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3Transpose);
+
+void BM_Matrix3Inverse(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  std::vector<Matrix3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].inverse(); });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3Inverse);
+
+void BM_Matrix3Row(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  std::vector<Vector3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) {
+    return a[i].row(static_cast<int>(i % 3));
+  });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3Row);
+
+void BM_Matrix3Col(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  std::vector<Vector3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) {
+    return a[i].col(static_cast<int>(i % 3));
+  });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3Col);
+
+void BM_Matrix3Equal(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  const std::vector<Matrix3> b{a};
+  std::vector<char> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] == b[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3Equal);
+
+void BM_Matrix3Stream(microbench::State &state) {
+  const std::vector<Matrix3> a{randomMatrices(batchSize(state))};
+  std::vector<std::string> out(a.size());
+  runBatch(state, out, [&](std::size_t i) {
+    std::ostringstream os;
+    os << a[i];
+    return os.str();
+  });
+}
+ISOMETRY_BENCHMARK(BM_Matrix3Stream);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
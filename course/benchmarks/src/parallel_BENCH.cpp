@@ -0,0 +1,72 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <vector>
+
+#include <isometry/parallel.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+// Particle filter sized batches.
+#define PARTICLES_BENCHMARK(function) \
+  MICROBENCH(function)->Arg(4096)->Arg(65536)->Arg(524288)
+
+void BM_IsometryComposeLoop(microbench::State &state) {
+  const Isometry motion{randomIsometries(1)[0]};
+  std::vector<Isometry> particles{randomIsometries(batchSize(state))};
+  while (state.KeepRunning()) {
+    for (Isometry &particle : particles) {
+      particle = motion * particle;
+    }
+    microbench::DoNotOptimize(particles.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(particles.size()));
+}
+PARTICLES_BENCHMARK(BM_IsometryComposeLoop);
+
+void BM_IsometryComposeBatch(microbench::State &state) {
+  const Isometry motion{randomIsometries(1)[0]};
+  std::vector<Isometry> particles{randomIsometries(batchSize(state))};
+  while (state.KeepRunning()) {
+    composeBatch(motion, particles);
+    microbench::DoNotOptimize(particles.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(particles.size()));
+}
+PARTICLES_BENCHMARK(BM_IsometryComposeBatch);
+
+void BM_IsometryInverseBatch(microbench::State &state) {
+  std::vector<Isometry> particles{randomIsometries(batchSize(state))};
+  while (state.KeepRunning()) {
+    inverseBatch(particles);
+    microbench::DoNotOptimize(particles.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(particles.size()));
+}
+PARTICLES_BENCHMARK(BM_IsometryInverseBatch);
+
+void BM_IsometryTransformBatch(microbench::State &state) {
+  const Isometry motion{randomIsometries(1)[0]};
+  std::vector<Vector3> points{randomVectors(batchSize(state))};
+  while (state.KeepRunning()) {
+    transformBatch(motion, points);
+    microbench::DoNotOptimize(points.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(points.size()));
+}
+PARTICLES_BENCHMARK(BM_IsometryTransformBatch);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
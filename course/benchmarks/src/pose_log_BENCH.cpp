@@ -0,0 +1,59 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <isometry/pose_log.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+const std::string kLogPath{
+    (std::filesystem::temp_directory_path() / "isometry_pose_log_BENCH")
+        .string()};
+
+void BM_PoseLogAppend(microbench::State &state) {
+  const std::vector<Isometry> isometries{randomIsometries(batchSize(state))};
+  while (state.KeepRunning()) {
+    IsometryLogWriter writer{kLogPath};
+    for (const Isometry &isometry : isometries) {
+      writer.append(isometry);
+    }
+  }
+  std::filesystem::remove(kLogPath);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(isometries.size()));
+}
+ISOMETRY_BENCHMARK(BM_PoseLogAppend);
+
+// Composes a whole mapped trajectory, page cache hot.
+void BM_PoseLogReplay(microbench::State &state) {
+  {
+    IsometryLogWriter writer{kLogPath};
+    writer.append(randomIsometries(batchSize(state)));
+  }
+  const IsometryLogReader reader{kLogPath};
+  while (state.KeepRunning()) {
+    Isometry pose{Isometry::fromTranslation(Vector3::kZero)};
+    for (const Isometry &step : reader.records()) {
+      pose = pose * step;
+    }
+    microbench::DoNotOptimize(pose);
+  }
+  std::filesystem::remove(kLogPath);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(reader.size()));
+}
+ISOMETRY_BENCHMARK(BM_PoseLogReplay);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,72 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+template <typename T>
+std::vector<BasicIsometry<T>> randomIsometriesOf(const std::size_t n) {
+  std::vector<BasicIsometry<T>> result;
+  for (const Isometry &isometry : randomIsometries(n)) {
+    result.push_back(isometry.cast<T>());
+  }
+  return result;
+}
+
+template <typename T>
+std::vector<BasicVector3<T>> randomVectorsOf(const std::size_t n) {
+  std::vector<BasicVector3<T>> result;
+  for (const Vector3 &vector : randomVectors(n)) {
+    result.push_back(vector.cast<T>());
+  }
+  return result;
+}
+
+template <typename T>
+void composeOf(microbench::State &state) {
+  const std::size_t n{batchSize(state)};
+  const std::vector<BasicIsometry<T>> a{randomIsometriesOf<T>(n)};
+  const std::vector<BasicIsometry<T>> b{randomIsometriesOf<T>(n)};
+  std::vector<BasicIsometry<T>> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].compose(b[i]); });
+}
+
+template <typename T>
+void transformOf(microbench::State &state) {
+  const std::size_t n{batchSize(state)};
+  const std::vector<BasicIsometry<T>> a{randomIsometriesOf<T>(n)};
+  const std::vector<BasicVector3<T>> v{randomVectorsOf<T>(n)};
+  std::vector<BasicVector3<T>> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * v[i]; });
+}
+
+void BM_IsometryfCompose(microbench::State &state) { composeOf<float>(state); }
+ISOMETRY_BENCHMARK(BM_IsometryfCompose);
+
+void BM_IsometrylCompose(microbench::State &state) {
+  composeOf<long double>(state);
+}
+ISOMETRY_BENCHMARK(BM_IsometrylCompose);
+
+void BM_IsometryfTransform(microbench::State &state) {
+  transformOf<float>(state);
+}
+ISOMETRY_BENCHMARK(BM_IsometryfTransform);
+
+void BM_IsometrylTransform(microbench::State &state) {
+  transformOf<long double>(state);
+}
+ISOMETRY_BENCHMARK(BM_IsometrylTransform);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,93 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <vector>
+
+#include <isometry/quaternion.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+std::vector<QuaternionIsometry> randomQuaternionIsometries(
+    const std::size_t n) {
+  std::vector<QuaternionIsometry> result;
+  result.reserve(n);
+  for (const Isometry &isometry : randomIsometries(n)) {
+    result.emplace_back(isometry);
+  }
+  return result;
+}
+
+void BM_QuaternionProduct(microbench::State &state) {
+  const std::vector<QuaternionIsometry> a{
+      randomQuaternionIsometries(batchSize(state))};
+  const std::vector<QuaternionIsometry> b{
+      randomQuaternionIsometries(batchSize(state))};
+  std::vector<Quaternion> out(a.size());
+  runBatch(state, out, [&](std::size_t i) {
+    return a[i].quaternion() * b[i].quaternion();
+  });
+}
+ISOMETRY_BENCHMARK(BM_QuaternionProduct);
+
+void BM_QuaternionNormalize(microbench::State &state) {
+  const std::vector<QuaternionIsometry> a{
+      randomQuaternionIsometries(batchSize(state))};
+  std::vector<Quaternion> out(a.size());
+  runBatch(state, out,
+           [&](std::size_t i) { return a[i].quaternion().normalized(); });
+}
+ISOMETRY_BENCHMARK(BM_QuaternionNormalize);
+
+void BM_QuaternionIsometryCompose(microbench::State &state) {
+  const std::vector<QuaternionIsometry> a{
+      randomQuaternionIsometries(batchSize(state))};
+  const std::vector<QuaternionIsometry> b{
+      randomQuaternionIsometries(batchSize(state))};
+  std::vector<QuaternionIsometry> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].compose(b[i]); });
+}
+ISOMETRY_BENCHMARK(BM_QuaternionIsometryCompose);
+
+void BM_QuaternionIsometryInverse(microbench::State &state) {
+  const std::vector<QuaternionIsometry> a{
+      randomQuaternionIsometries(batchSize(state))};
+  std::vector<QuaternionIsometry> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].inverse(); });
+}
+ISOMETRY_BENCHMARK(BM_QuaternionIsometryInverse);
+
+void BM_QuaternionIsometryTransform(microbench::State &state) {
+  const std::vector<QuaternionIsometry> a{
+      randomQuaternionIsometries(batchSize(state))};
+  const std::vector<Vector3> v{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i] * v[i]; });
+}
+ISOMETRY_BENCHMARK(BM_QuaternionIsometryTransform);
+
+void BM_QuaternionIsometryRotation(microbench::State &state) {
+  const std::vector<QuaternionIsometry> a{
+      randomQuaternionIsometries(batchSize(state))};
+  std::vector<Matrix3> out(a.size());
+  runBatch(state, out, [&](std::size_t i) { return a[i].rotation(); });
+}
+ISOMETRY_BENCHMARK(BM_QuaternionIsometryRotation);
+
+void BM_QuaternionIsometryFromIsometry(microbench::State &state) {
+  const std::vector<Isometry> a{randomIsometries(batchSize(state))};
+  std::vector<QuaternionIsometry> out(a.size());
+  runBatch(state, out,
+           [&](std::size_t i) { return QuaternionIsometry{a[i]}; });
+}
+ISOMETRY_BENCHMARK(BM_QuaternionIsometryFromIsometry);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
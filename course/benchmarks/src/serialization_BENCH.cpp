@@ -0,0 +1,84 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
+#include <isometry/serialization.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+// Text serialization through operator<<, for reference.
+void BM_IsometryArrayStreamEncode(microbench::State &state) {
+  const std::vector<Isometry> isometries{randomIsometries(batchSize(state))};
+  while (state.KeepRunning()) {
+    std::ostringstream os;
+    for (const Isometry &isometry : isometries) {
+      os << isometry << '\n';
+    }
+    microbench::DoNotOptimize(os.str());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(isometries.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryArrayStreamEncode);
+
+void BM_IsometryArrayEncode(microbench::State &state) {
+  const std::vector<Isometry> isometries{randomIsometries(batchSize(state))};
+  std::vector<std::uint8_t> buffer;
+  while (state.KeepRunning()) {
+    buffer.clear();
+    serialization::encode(isometries, buffer);
+    microbench::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(isometries.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryArrayEncode);
+
+void BM_IsometryArrayDecode(microbench::State &state) {
+  std::vector<std::uint8_t> buffer;
+  serialization::encode(randomIsometries(batchSize(state)), buffer);
+  while (state.KeepRunning()) {
+    microbench::DoNotOptimize(serialization::decodeIsometries(buffer));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(batchSize(state)));
+}
+ISOMETRY_BENCHMARK(BM_IsometryArrayDecode);
+
+void BM_IsometryArrayCompactEncode(microbench::State &state) {
+  const std::vector<Isometry> isometries{randomIsometries(batchSize(state))};
+  std::vector<std::uint8_t> buffer;
+  while (state.KeepRunning()) {
+    buffer.clear();
+    serialization::encodeCompact(isometries, buffer);
+    microbench::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(isometries.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryArrayCompactEncode);
+
+void BM_IsometryArrayCompactDecode(microbench::State &state) {
+  std::vector<std::uint8_t> buffer;
+  serialization::encodeCompact(randomIsometries(batchSize(state)), buffer);
+  while (state.KeepRunning()) {
+    microbench::DoNotOptimize(serialization::decodeCompactIsometries(buffer));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(batchSize(state)));
+}
+ISOMETRY_BENCHMARK(BM_IsometryArrayCompactDecode);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,68 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <isometry/text.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+void BM_IsometryStreamFormat(microbench::State &state) {
+  const std::vector<Isometry> isometries{randomIsometries(batchSize(state))};
+  while (state.KeepRunning()) {
+    for (const Isometry &isometry : isometries) {
+      std::ostringstream os;
+      os << isometry;
+      microbench::DoNotOptimize(os.str());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(isometries.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryStreamFormat);
+
+void BM_IsometryToChars(microbench::State &state) {
+  const std::vector<Isometry> isometries{randomIsometries(batchSize(state))};
+  char buffer[kIsometryMaxChars];
+  while (state.KeepRunning()) {
+    for (const Isometry &isometry : isometries) {
+      microbench::DoNotOptimize(
+          toChars(buffer, buffer + sizeof(buffer), isometry).ptr);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(isometries.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryToChars);
+
+void BM_IsometryFromChars(microbench::State &state) {
+  std::vector<std::string> texts;
+  char buffer[kIsometryMaxChars];
+  for (const Isometry &isometry : randomIsometries(batchSize(state))) {
+    texts.emplace_back(buffer,
+                       toChars(buffer, buffer + sizeof(buffer), isometry).ptr);
+  }
+  Isometry isometry;
+  while (state.KeepRunning()) {
+    for (const std::string &text : texts) {
+      fromChars(text.data(), text.data() + text.size(), isometry);
+      microbench::DoNotOptimize(isometry);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(texts.size()));
+}
+ISOMETRY_BENCHMARK(BM_IsometryFromChars);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
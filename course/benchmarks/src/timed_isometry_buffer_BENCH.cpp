@@ -0,0 +1,49 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <vector>
+
+#include <isometry/timed_isometry_buffer.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+// Fills a buffer of the benchmark batch size, one entry per time unit.
+TimedIsometryBuffer filledBuffer(const std::size_t size) {
+  TimedIsometryBuffer buffer{size};
+  const std::vector<Isometry> isometries{randomIsometries(size)};
+  for (std::size_t i = 0; i < size; ++i) {
+    buffer.insert(static_cast<double>(i), isometries[i]);
+  }
+  return buffer;
+}
+
+void BM_TimedIsometryBufferInsert(microbench::State &state) {
+  TimedIsometryBuffer buffer{filledBuffer(batchSize(state))};
+  const Isometry isometry{randomIsometries(1).front()};
+  double time{buffer.newestTime()};
+  while (state.KeepRunning()) {
+    time += 1.;
+    buffer.insert(time, isometry);
+  }
+}
+ISOMETRY_BENCHMARK(BM_TimedIsometryBufferInsert);
+
+void BM_TimedIsometryBufferLookup(microbench::State &state) {
+  const TimedIsometryBuffer buffer{filledBuffer(batchSize(state))};
+  const std::vector<double> times{
+      randomScalars(batchSize(state), 0., buffer.newestTime())};
+  std::vector<Isometry> out(times.size());
+  runBatch(state, out, [&](std::size_t i) { return buffer.lookup(times[i]); });
+}
+ISOMETRY_BENCHMARK(BM_TimedIsometryBufferLookup);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,53 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <vector>
+
+#include <isometry/transform_chain.hpp>
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+// Pushes a few points through a chain of three isometries, which is where
+// the evaluation order matters.
+#define CHAIN_BENCHMARK(function) \
+  MICROBENCH(function)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)
+
+void BM_ChainComposeFirst(microbench::State &state) {
+  const std::vector<Isometry> chain{randomIsometries(3)};
+  const std::vector<Vector3> points{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(points.size());
+  while (state.KeepRunning()) {
+    const Isometry composed{chain[0] * chain[1] * chain[2]};
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      out[i] = composed * points[i];
+    }
+    microbench::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(points.size()));
+}
+CHAIN_BENCHMARK(BM_ChainComposeFirst);
+
+void BM_ChainTransformChain(microbench::State &state) {
+  const std::vector<Isometry> chain{randomIsometries(3)};
+  const std::vector<Vector3> points{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(points.size());
+  while (state.KeepRunning()) {
+    (TransformChain{chain[0]} * chain[1] * chain[2]).transform(points, out);
+    microbench::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(points.size()));
+}
+CHAIN_BENCHMARK(BM_ChainTransformChain);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,144 @@
+/* Copyright 2020, Ekumen
+ * Isometry library benchmarks
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <sstream>
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace ekumen {
+namespace math {
+namespace benchmark {
+namespace {
+
+void BM_Vector3Construct(microbench::State &state) {
+  const std::vector<double> s{randomScalars(batchSize(state))};
+  std::vector<Vector3> out(s.size());
+  runBatch(state, out,
+           [&](std::size_t i) { return Vector3{s[i], s[i], s[i]}; });
+}
+ISOMETRY_BENCHMARK(BM_Vector3Construct);
+
+void BM_Vector3Add(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  const std::vector<Vector3> q{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(p.size());
+  runBatch(state, out, [&](std::size_t i) { return p[i] + q[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Vector3Add);
+
+void BM_Vector3Subtract(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  const std::vector<Vector3> q{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(p.size());
+  runBatch(state, out, [&](std::size_t i) { return p[i] - q[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Vector3Subtract);
+
+void BM_Vector3Multiply(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  const std::vector<Vector3> q{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(p.size());
+  runBatch(state, out, [&](std::size_t i) { return p[i] * q[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Vector3Multiply);
+
+void BM_Vector3Divide(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  const std::vector<Vector3> q{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(p.size());
+  runBatch(state, out, [&](std::size_t i) { return p[i] / q[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Vector3Divide);
+
+void BM_Vector3ScalarMultiply(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  const std::vector<double> s{randomScalars(batchSize(state))};
+  std::vector<Vector3> out(p.size());
+  runBatch(state, out, [&](std::size_t i) { return s[i] * p[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Vector3ScalarMultiply);
+
+void BM_Vector3ScalarDivide(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  const std::vector<double> s{randomScalars(batchSize(state), 1., 10.)};
+  std::vector<Vector3> out(p.size());
+  runBatch(state, out, [&](std::size_t i) { return p[i] / s[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Vector3ScalarDivide);
+
+void BM_Vector3CompoundAdd(microbench::State &state) {
+  const std::vector<Vector3> q{randomVectors(batchSize(state))};
+  std::vector<Vector3> out{randomVectors(batchSize(state))};
+  runBatch(state, out, [&](std::size_t i) { return out[i] += q[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Vector3CompoundAdd);
+
+void BM_Vector3ChainedExpression(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  const std::vector<Vector3> q{randomVectors(batchSize(state))};
+  const std::vector<Vector3> r{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(p.size());
+  runBatch(state, out, [&](std::size_t i) {
+    return 2. * p[i] + q[i] * r[i] - r[i] / 2. + p[i] - q[i];
+  });
+}
+ISOMETRY_BENCHMARK(BM_Vector3ChainedExpression);
+
+void BM_Vector3Dot(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  const std::vector<Vector3> q{randomVectors(batchSize(state))};
+  std::vector<double> out(p.size());
+  runBatch(state, out, [&](std::size_t i) { return p[i].dot(q[i]); });
+}
+ISOMETRY_BENCHMARK(BM_Vector3Dot);
+
+void BM_Vector3Cross(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  const std::vector<Vector3> q{randomVectors(batchSize(state))};
+  std::vector<Vector3> out(p.size());
+  runBatch(state, out, [&](std::size_t i) { return p[i].cross(q[i]); });
+}
+ISOMETRY_BENCHMARK(BM_Vector3Cross);
+
+void BM_Vector3Norm(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  std::vector<double> out(p.size());
+  runBatch(state, out, [&](std::size_t i) { return p[i].norm(); });
+}
+ISOMETRY_BENCHMARK(BM_Vector3Norm);
+
+void BM_Vector3Equal(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  const std::vector<Vector3> q{p};
+  std::vector<char> out(p.size());
+  runBatch(state, out, [&](std::size_t i) { return p[i] == q[i]; });
+}
+ISOMETRY_BENCHMARK(BM_Vector3Equal);
+
+void BM_Vector3Index(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  std::vector<double> out(p.size());
+  runBatch(state, out, [&](std::size_t i) {
+    return p[i][static_cast<int>(i % 3)];
+  });
+}
+ISOMETRY_BENCHMARK(BM_Vector3Index);
+
+void BM_Vector3Stream(microbench::State &state) {
+  const std::vector<Vector3> p{randomVectors(batchSize(state))};
+  std::vector<std::string> out(p.size());
+  runBatch(state, out, [&](std::size_t i) {
+    std::ostringstream os;
+    os << p[i];
+    return os.str();
+  });
+}
+ISOMETRY_BENCHMARK(BM_Vector3Stream);
+
+}  // namespace
+}  // namespace benchmark
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,69 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <stdexcept>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Isometry built up through a long chain of compositions, e.g. the pose of
+// an integrator updated with a *= delta at every step.
+//
+// Each composition rounds the rotation a little off orthonormality, and the
+// drift grows linearly with the number of compositions: about 3000 epsilon
+// after ten thousand of them, well beyond BasicMatrix3::kRotationTolerance.
+// This re-orthonormalizes the rotation every |period| compositions, which
+// keeps it within a few epsilon per |period| compositions, for about one
+// extra composition's worth of work each time.
+template <typename T>
+class BasicAccumulatedIsometry {
+ public:
+  static constexpr int kDefaultPeriod{64};
+
+  // Throws std::invalid_argument if |period| is not positive, and
+  // std::domain_error if |initial| is too far from rigid, see
+  // BasicMatrix3::orthonormalized().
+  explicit BasicAccumulatedIsometry(
+      const BasicIsometry<T> &initial =
+          BasicIsometry<T>::fromTranslation(BasicVector3<T>::kZero),
+      const int period = kDefaultPeriod)
+      : isometry_{initial.orthonormalized()}, period_{period} {
+    if (period <= 0) {
+      throw std::invalid_argument("The period must be positive");
+    }
+  }
+
+  BasicAccumulatedIsometry &operator*=(const BasicIsometry<T> &rhs) {
+    isometry_ *= rhs;
+    if (++compositions_ == period_) {
+      compositions_ = 0;
+      isometry_ = isometry_.orthonormalized();
+    }
+    return *this;
+  }
+
+  const BasicIsometry<T> &isometry() const { return isometry_; }
+  int period() const { return period_; }
+
+ private:
+  BasicIsometry<T> isometry_;
+  int period_;
+  // Compositions since the last re-orthonormalization.
+  int compositions_{0};
+};
+
+using AccumulatedIsometry = BasicAccumulatedIsometry<double>;
+using AccumulatedIsometryf = BasicAccumulatedIsometry<float>;
+using AccumulatedIsometryl = BasicAccumulatedIsometry<long double>;
+
+}  // namespace math
+
+}  // namespace ekumen
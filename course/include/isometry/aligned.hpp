@@ -0,0 +1,150 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <ostream>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+namespace detail {
+
+// Selects constructors that leave elements uninitialized, for results that a
+// kernel overwrites whole.
+struct Uninitialized {};
+
+}  // namespace detail
+
+class AlignedMatrix3;
+
+// Padded storage layout for vectors and matrices of doubles.
+//
+// Vector3 and Matrix3 are packed, 24 and 72 bytes, so arrays of them straddle
+// cache lines and their rows can't be loaded with aligned full-width loads.
+// AlignedVector3 keeps its three elements in four doubles, the last of which
+// is always zero, aligned to 32 bytes, and AlignedMatrix3 is three such rows.
+// Matrix and matrix-vector products go through aligned kernels that load and
+// store whole rows, and give results bit-identical to the packed ones.
+//
+// The layout is chosen per type, by picking either the packed or the padded
+// one. Conversions between both are element copies. The padded types are
+// plain values: arithmetic other than products should convert to the packed
+// types, which carry the expression machinery.
+class alignas(32) AlignedVector3 {
+ public:
+  constexpr AlignedVector3() : AlignedVector3(0., 0., 0.) {}
+  constexpr AlignedVector3(const double x, const double y, const double z)
+      : values_{x, y, z, 0.} {}
+  constexpr explicit AlignedVector3(const Vector3 &v)
+      : AlignedVector3(v.x(), v.y(), v.z()) {}
+
+  constexpr double &x() { return values_[0]; }
+  constexpr double &y() { return values_[1]; }
+  constexpr double &z() { return values_[2]; }
+  constexpr const double &x() const { return values_[0]; }
+  constexpr const double &y() const { return values_[1]; }
+  constexpr const double &z() const { return values_[2]; }
+
+  constexpr double &operator[](const int index) {
+    detail::checkIndex(index);
+    return values_[index];
+  }
+  constexpr const double &operator[](const int index) const {
+    detail::checkIndex(index);
+    return values_[index];
+  }
+
+  // Four doubles, the last of which is padding and must be left zero.
+  constexpr double *data() { return values_; }
+  constexpr const double *data() const { return values_; }
+
+  // Same vector in the packed layout.
+  constexpr Vector3 compact() const {
+    return Vector3{values_[0], values_[1], values_[2]};
+  }
+
+ private:
+  friend class AlignedMatrix3;
+  friend AlignedVector3 operator*(const AlignedMatrix3 &lhs,
+                                  const AlignedVector3 &rhs);
+
+  explicit AlignedVector3(detail::Uninitialized) {}
+
+  double values_[4];
+};
+
+class alignas(32) AlignedMatrix3 {
+ public:
+  constexpr AlignedMatrix3() = default;
+  constexpr AlignedMatrix3(const AlignedVector3 &row0,
+                           const AlignedVector3 &row1,
+                           const AlignedVector3 &row2)
+      : rows_{row0, row1, row2} {}
+  constexpr explicit AlignedMatrix3(const Matrix3 &m)
+      : rows_{AlignedVector3{m.get<0>()}, AlignedVector3{m.get<1>()},
+              AlignedVector3{m.get<2>()}} {}
+
+  constexpr AlignedVector3 &operator[](const int index) {
+    detail::checkIndex(index);
+    return rows_[index];
+  }
+  constexpr const AlignedVector3 &operator[](const int index) const {
+    detail::checkIndex(index);
+    return rows_[index];
+  }
+
+  // Twelve doubles, three padded rows in row-major order.
+  constexpr double *data() { return rows_[0].data(); }
+  constexpr const double *data() const { return rows_[0].data(); }
+
+  // Same matrix in the packed layout.
+  constexpr Matrix3 compact() const {
+    return Matrix3{rows_[0].compact(), rows_[1].compact(),
+                   rows_[2].compact()};
+  }
+
+  // Matrix product, like Matrix3::product().
+  AlignedMatrix3 product(const AlignedMatrix3 &rhs) const;
+
+  friend AlignedVector3 operator*(const AlignedMatrix3 &lhs,
+                                  const AlignedVector3 &rhs);
+
+ private:
+  explicit AlignedMatrix3(detail::Uninitialized)
+      : rows_{AlignedVector3{detail::Uninitialized{}},
+              AlignedVector3{detail::Uninitialized{}},
+              AlignedVector3{detail::Uninitialized{}}} {}
+
+  AlignedVector3 rows_[3];
+};
+
+static_assert(sizeof(AlignedVector3) == 32, "Rows must be one 256-bit word");
+static_assert(sizeof(AlignedMatrix3) == 96, "Rows must not be padded further");
+
+// Same tolerance as the packed types.
+inline bool operator==(const AlignedVector3 &lhs, const AlignedVector3 &rhs) {
+  return lhs.compact() == rhs.compact();
+}
+inline bool operator!=(const AlignedVector3 &lhs, const AlignedVector3 &rhs) {
+  return !(lhs == rhs);
+}
+inline bool operator==(const AlignedMatrix3 &lhs, const AlignedMatrix3 &rhs) {
+  return lhs.compact() == rhs.compact();
+}
+inline bool operator!=(const AlignedMatrix3 &lhs, const AlignedMatrix3 &rhs) {
+  return !(lhs == rhs);
+}
+
+std::ostream &operator<<(std::ostream &os, const AlignedVector3 &v);
+std::ostream &operator<<(std::ostream &os, const AlignedMatrix3 &m);
+
+}  // namespace math
+
+}  // namespace ekumen
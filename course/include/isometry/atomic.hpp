@@ -0,0 +1,103 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Single-writer, multi-reader publication of a value through a sequence
+// lock. store() is wait-free and never waits for readers, and load() never
+// takes a lock: it retries while a store is in progress, so readers always
+// get a consistent snapshot.
+//
+// The value is kept as atomic words, which makes concurrent stores and loads
+// free of data races as far as the language (and ThreadSanitizer) is
+// concerned. Only one thread may call store() at a time.
+template <typename T>
+class alignas(64) AtomicSnapshot {
+ public:
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Snapshots are copied word by word");
+  static_assert(sizeof(T) % sizeof(std::uint64_t) == 0,
+                "Snapshots are copied word by word");
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                "64-bit atomics must be lock-free");
+
+  AtomicSnapshot() : AtomicSnapshot(T{}) {}
+  explicit AtomicSnapshot(const T &value) { store(value); }
+
+  AtomicSnapshot(const AtomicSnapshot &) = delete;
+  AtomicSnapshot &operator=(const AtomicSnapshot &) = delete;
+
+  // Publishes |value|. Must not be called concurrently with itself.
+  void store(const T &value) {
+    std::uint64_t words[kWords];
+    std::memcpy(words, &value, sizeof(T));
+    const std::uint64_t sequence{sequence_.load(std::memory_order_relaxed)};
+    // An odd sequence number flags a store in progress. Storing the words
+    // with release semantics makes a reader that sees any of them also see
+    // the odd sequence number. Fences would be cheaper on some platforms,
+    // but ThreadSanitizer does not understand them.
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    for (int i = 0; i < kWords; ++i) {
+      words_[i].store(words[i], std::memory_order_release);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  // Returns the last published value.
+  T load() const {
+    T value;
+    while (!tryLoad(value)) {
+    }
+    return value;
+  }
+
+  // Single attempt at reading the last published value. Returns false,
+  // leaving |value| untouched, if a store overlapped the read.
+  bool tryLoad(T &value) const {
+    const std::uint64_t before{sequence_.load(std::memory_order_acquire)};
+    if ((before & 1) != 0) {
+      return false;
+    }
+    std::uint64_t words[kWords];
+    for (int i = 0; i < kWords; ++i) {
+      words[i] = words_[i].load(std::memory_order_acquire);
+    }
+    if (sequence_.load(std::memory_order_relaxed) != before) {
+      return false;
+    }
+    std::memcpy(&value, words, sizeof(T));
+    return true;
+  }
+
+  // Number of stores so far, e.g. for readers to detect new values.
+  std::uint64_t version() const {
+    return sequence_.load(std::memory_order_acquire) / 2;
+  }
+
+ private:
+  static constexpr int kWords{sizeof(T) / sizeof(std::uint64_t)};
+
+  std::atomic<std::uint64_t> sequence_{0};
+  std::atomic<std::uint64_t> words_[kWords];
+};
+
+using AtomicVector3 = AtomicSnapshot<Vector3>;
+using AtomicIsometry = AtomicSnapshot<Isometry>;
+
+}  // namespace math
+
+}  // namespace ekumen
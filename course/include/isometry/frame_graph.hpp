@@ -0,0 +1,115 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Tree of coordinate frames linked by isometries. Each frame but the root has
+// a parent, and the edge to it holds the isometry that maps points in the
+// frame to points in its parent.
+//
+// The isometry from each frame to the root is computed on first use and
+// cached. Updating an edge only drops the cached values of the frames under
+// it, so queries cost O(depth) after an update and O(1) afterwards.
+//
+// Queries update the cache, so concurrent use of a FrameGraph, even through
+// const methods only, must be externally synchronized.
+//
+// Every allocation, names included, comes from the memory resource given on
+// construction, e.g. a std::pmr::monotonic_buffer_resource that releases a
+// whole graph at once. Name lookups don't allocate.
+class FrameGraph {
+ public:
+  using FrameId = std::size_t;
+
+  static constexpr FrameId kRootId{0};
+
+  explicit FrameGraph(
+      std::string_view root_name,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  // Adds a frame whose points map to |parent| through |parent_from_frame|.
+  // Throws std::invalid_argument if |name| is already in use, and
+  // std::out_of_range if |parent| does not exist.
+  FrameId addFrame(std::string_view name, const FrameId parent,
+                   const Isometry &parent_from_frame);
+  FrameId addFrame(std::string_view name, std::string_view parent,
+                   const Isometry &parent_from_frame);
+
+  // Updates the edge from |frame| to its parent. Throws std::out_of_range if
+  // |frame| does not exist, and std::invalid_argument if it is the root.
+  void setTransform(const FrameId frame, const Isometry &parent_from_frame);
+  void setTransform(std::string_view frame, const Isometry &parent_from_frame);
+
+  // Frame lookups. Throw std::out_of_range on unknown frames.
+  FrameId id(std::string_view name) const;
+  std::string_view name(const FrameId frame) const;
+  FrameId parent(const FrameId frame) const;
+  const Isometry &parentTransform(const FrameId frame) const;
+
+  bool contains(std::string_view name) const;
+  std::size_t size() const { return frames_.size(); }
+
+  // Isometry that maps points in |frame| to points in the root frame.
+  const Isometry &rootTransform(const FrameId frame) const;
+  const Isometry &rootTransform(std::string_view frame) const;
+
+  // Isometry that maps points in |source| to points in |target|.
+  Isometry relativeTransform(const FrameId target, const FrameId source) const;
+  Isometry relativeTransform(std::string_view target,
+                             std::string_view source) const;
+
+  std::pmr::memory_resource *resource() const {
+    return frames_.get_allocator().resource();
+  }
+
+ private:
+  struct Frame {
+    std::pmr::string name;
+    FrameId parent;
+    Isometry parent_from_frame;
+    std::pmr::vector<FrameId> children;
+    // A cached value is only valid if the ones of all the ancestors are.
+    mutable Isometry root_from_frame;
+    mutable bool cached;
+  };
+
+  // Lets |ids_| be searched by std::string_view.
+  struct NameHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view name) const {
+      return std::hash<std::string_view>{}(name);
+    }
+  };
+
+  const Frame &frame(const FrameId frame) const;
+  Frame &frame(const FrameId frame);
+  void invalidate(const FrameId frame);
+
+  std::pmr::vector<Frame> frames_;
+  std::pmr::unordered_map<std::pmr::string, FrameId, NameHash,
+                          std::equal_to<>>
+      ids_;
+  // Scratch stack for rootTransform(), reused across calls.
+  mutable std::pmr::vector<FrameId> path_;
+};
+
+}  // namespace math
+
+}  // namespace ekumen
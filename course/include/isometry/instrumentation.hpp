@@ -0,0 +1,140 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace ekumen {
+
+namespace math {
+
+namespace instrumentation {
+
+// Call counters and latency histograms of selected library operations, for
+// processes that need to know how much time they spend in them.
+//
+// Instrumentation is compiled out unless the library is configured with
+// -DISOMETRY_ENABLE_INSTRUMENTATION=ON. When enabled, every call of an
+// instrumented operation increments a counter of the calling thread, and one
+// in kSamplingPeriod calls per thread is also timed into a histogram. Calls
+// the library makes internally count too, e.g. inverting an isometry takes
+// the determinant of its rotation.
+//
+// Counters are thread local, written without atomic read-modify-write
+// operations, and merged when a snapshot is taken. The counters of threads
+// that have exited are kept. Counters only grow: rates come from the
+// difference between two snapshots.
+
+#ifdef ISOMETRY_ENABLE_INSTRUMENTATION
+constexpr bool kEnabled{true};
+#else
+constexpr bool kEnabled{false};
+#endif
+
+enum class Operation {
+  kIsometryCompose,
+  kIsometryInverse,
+  kIsometryFromEulerAngles,
+  kMatrix3Det,
+};
+
+constexpr int kOperationCount{4};
+
+// Histogram bucket i counts latencies in [2^i, 2^(i + 1)) nanoseconds, except
+// for the first one, which also counts zero, and the last one, which has no
+// upper bound.
+constexpr int kHistogramBuckets{32};
+constexpr std::uint64_t kSamplingPeriod{64};
+
+// Name of |operation|, e.g. "isometry_compose".
+std::string_view name(const Operation operation);
+
+struct OperationStats {
+  std::uint64_t calls{0};
+  // Number of timed calls, the sum of the histogram.
+  std::uint64_t samples{0};
+  std::array<std::uint64_t, kHistogramBuckets> latency_histogram{};
+  // Total latency of the timed calls, in nanoseconds.
+  std::uint64_t latency_sum{0};
+
+  // Inclusive upper bound, in nanoseconds, of the bucket that holds the
+  // |quantile| sample, e.g. 0.5 for the median. Zero if there are no samples.
+  std::uint64_t latencyQuantile(const double quantile) const;
+};
+
+struct Snapshot {
+  std::array<OperationStats, kOperationCount> operations{};
+
+  const OperationStats &operator[](const Operation operation) const {
+    return operations[static_cast<int>(operation)];
+  }
+};
+
+// Counters of every thread, past and present, merged. Safe to call from any
+// thread, concurrently with instrumented operations. Always zero when
+// instrumentation is compiled out.
+Snapshot snapshot();
+
+// Writes |snapshot| in the Prometheus text format: a counter of calls and a
+// histogram of sampled latencies per operation, e.g.
+// isometry_compose_calls_total and isometry_compose_latency_ns.
+void dump(const Snapshot &snapshot, std::ostream &os);
+
+namespace detail {
+
+// Counts a call of |operation| on this thread. Returns the start timestamp if
+// the call is sampled, zero otherwise.
+std::uint64_t begin(const Operation operation);
+// Records the latency of a sampled call.
+void end(const Operation operation, const std::uint64_t start);
+
+}  // namespace detail
+
+// Instruments the enclosing scope as a call of an operation. Constant
+// evaluation is not counted, so it can be used in constexpr functions.
+class ScopedSample {
+ public:
+  constexpr explicit ScopedSample(const Operation operation)
+      : operation_{operation} {
+    if (!std::is_constant_evaluated()) {
+      start_ = detail::begin(operation_);
+    }
+  }
+  constexpr ~ScopedSample() {
+    if (!std::is_constant_evaluated() && (start_ != 0)) {
+      detail::end(operation_, start_);
+    }
+  }
+
+  ScopedSample(const ScopedSample &) = delete;
+  ScopedSample &operator=(const ScopedSample &) = delete;
+
+ private:
+  Operation operation_;
+  std::uint64_t start_{0};
+};
+
+}  // namespace instrumentation
+
+}  // namespace math
+
+}  // namespace ekumen
+
+// Instruments the enclosing function as a call of |operation|, one of the
+// Operation enumerators. Expands to nothing unless instrumentation is
+// enabled.
+#ifdef ISOMETRY_ENABLE_INSTRUMENTATION
+#define ISOMETRY_INSTRUMENT(operation)                                 \
+  const ::ekumen::math::instrumentation::ScopedSample isometry_sample_{ \
+      ::ekumen::math::instrumentation::Operation::operation}
+#else
+#define ISOMETRY_INSTRUMENT(operation)
+#endif
@@ -6,19 +6,1211 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <initializer_list>
 #include <iostream>
+#include <limits>
+#include <memory_resource>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <vector>
+
+#include <isometry/instrumentation.hpp>
 
 namespace ekumen {
 
 namespace math {
 
-/*
- * your code here
- */
+template <typename T>
+class BasicVector3;
+template <typename T>
+class BasicMatrix3;
+template <typename T>
+class BasicIsometry;
+template <typename T>
+struct BasicTwist;
+
+// Vectors, matrices and isometries are templates on their scalar type, which
+// may be float, double or long double. The double instantiations are the
+// main ones: only they are backed by the SIMD kernels and have batch
+// transforms and serialization support.
+using Vector3 = BasicVector3<double>;
+using Matrix3 = BasicMatrix3<double>;
+using Isometry = BasicIsometry<double>;
+using Twist = BasicTwist<double>;
+using Vector3f = BasicVector3<float>;
+using Matrix3f = BasicMatrix3<float>;
+using Isometryf = BasicIsometry<float>;
+using Twistf = BasicTwist<float>;
+using Vector3l = BasicVector3<long double>;
+using Matrix3l = BasicMatrix3<long double>;
+using Isometryl = BasicIsometry<long double>;
+using Twistl = BasicTwist<long double>;
+
+namespace detail {
+
+// std::abs is not usable in constant expressions before C++23.
+template <typename T>
+constexpr T absolute(const T value) {
+  return value < T{0} ? -value : value;
+}
+
+// Relative comparison, within one epsilon of the scalar type.
+template <typename T>
+constexpr bool almostEqual(const T lhs, const T rhs) {
+  const T scale{std::max({T{1}, absolute(lhs), absolute(rhs)})};
+  return absolute(lhs - rhs) <= std::numeric_limits<T>::epsilon() * scale;
+}
+
+// Throws std::out_of_range. Kept out of line so that the checked accessors
+// inline to a compare and a cold call.
+[[noreturn]] void throwIndexOutOfRange(const int index);
+
+// Range check of the element accessors. Builds configured with
+// ISOMETRY_DISABLE_BOUNDS_CHECKS compile it away.
+constexpr void checkIndex([[maybe_unused]] const int index) {
+#ifndef ISOMETRY_DISABLE_BOUNDS_CHECKS
+  if ((index < 0) || (index > 2)) {
+    throwIndexOutOfRange(index);
+  }
+#endif
+}
+
+struct Add {
+  template <typename T>
+  static constexpr T apply(const T lhs, const T rhs) {
+    return lhs + rhs;
+  }
+};
+
+struct Subtract {
+  template <typename T>
+  static constexpr T apply(const T lhs, const T rhs) {
+    return lhs - rhs;
+  }
+};
+
+struct Multiply {
+  template <typename T>
+  static constexpr T apply(const T lhs, const T rhs) {
+    return lhs * rhs;
+  }
+};
+
+struct Divide {
+  template <typename T>
+  static constexpr T apply(const T lhs, const T rhs) {
+    return lhs / rhs;
+  }
+};
+
+// Expressions hold vectors and matrices by reference, and other expressions
+// by value, so that nested expressions don't refer to destroyed temporaries.
+template <typename E>
+struct Nested {
+  typedef const E type;
+};
+
+template <typename T>
+struct Nested<BasicVector3<T>> {
+  typedef const BasicVector3<T> &type;
+};
+
+template <typename T>
+struct Nested<BasicMatrix3<T>> {
+  typedef const BasicMatrix3<T> &type;
+};
+
+// Scalar type shared by both operands of a binary expression.
+template <typename Lhs, typename Rhs>
+struct CommonScalar {
+  static_assert(std::is_same_v<typename Lhs::Scalar, typename Rhs::Scalar>,
+                "Mixed precision expressions need an explicit cast()");
+  typedef typename Lhs::Scalar type;
+};
+
+// Matrix-vector products through the dispatched kernels.
+BasicVector3<double> productKernel(const BasicMatrix3<double> &lhs,
+                                   const BasicVector3<double> &rhs);
+
+}  // namespace detail
+
+// Base of all the lazily evaluated element-wise vector expressions. The
+// arithmetic operators return expression objects, which are only evaluated,
+// in a single loop, when assigned to a Vector3.
+template <typename E>
+class VectorExpression {
+ public:
+  constexpr auto element(const int index) const {
+    return static_cast<const E &>(*this).element(index);
+  }
+
+  // Evaluates the expression, e.g. to call Vector3 members on the result.
+  constexpr auto eval() const;
+
+ protected:
+  constexpr VectorExpression() = default;
+};
+
+template <typename Lhs, typename Rhs, typename Op>
+class VectorBinaryExpression
+    : public VectorExpression<VectorBinaryExpression<Lhs, Rhs, Op>> {
+ public:
+  typedef typename detail::CommonScalar<Lhs, Rhs>::type Scalar;
+
+  constexpr VectorBinaryExpression(const Lhs &lhs, const Rhs &rhs)
+      : lhs_(lhs), rhs_(rhs) {}
+
+  constexpr Scalar element(const int index) const {
+    return Op::apply(lhs_.element(index), rhs_.element(index));
+  }
+
+ private:
+  typename detail::Nested<Lhs>::type lhs_;
+  typename detail::Nested<Rhs>::type rhs_;
+};
+
+template <typename E, typename Op>
+class VectorScalarExpression
+    : public VectorExpression<VectorScalarExpression<E, Op>> {
+ public:
+  typedef typename E::Scalar Scalar;
+
+  constexpr VectorScalarExpression(const E &expression, const Scalar scalar)
+      : expression_(expression), scalar_{scalar} {}
+
+  constexpr Scalar element(const int index) const {
+    return Op::apply(expression_.element(index), scalar_);
+  }
+
+ private:
+  typename detail::Nested<E>::type expression_;
+  const Scalar scalar_;
+};
+
+// Three element vector, designating an (x, y, z) coordinate in a frame.
+template <typename T>
+class BasicVector3 : public VectorExpression<BasicVector3<T>> {
+ public:
+  typedef T Scalar;
+
+  static const BasicVector3 kUnitX;
+  static const BasicVector3 kUnitY;
+  static const BasicVector3 kUnitZ;
+  static const BasicVector3 kZero;
+
+  constexpr BasicVector3() : BasicVector3(T{0}, T{0}, T{0}) {}
+  constexpr BasicVector3(const T x, const T y, const T z)
+      : values_{x, y, z} {}
+  constexpr BasicVector3(std::initializer_list<T> values) : values_{} {
+    if (values.size() != 3) {
+      throw std::invalid_argument("A Vector3 must be built from three values");
+    }
+    std::copy(values.begin(), values.end(), values_);
+  }
+  // Expressions of other scalar types need an explicit cast().
+  template <typename E>
+    requires std::is_same_v<typename E::Scalar, T>
+  constexpr BasicVector3(  // NOLINT(runtime/explicit)
+      const VectorExpression<E> &expression)
+      : values_{expression.element(0), expression.element(1),
+                expression.element(2)} {}
+
+  template <typename E>
+    requires std::is_same_v<typename E::Scalar, T>
+  constexpr BasicVector3 &operator=(const VectorExpression<E> &expression) {
+    // Expressions are element-wise, so evaluating in place is alias-safe.
+    for (int i = 0; i < 3; ++i) {
+      values_[i] = expression.element(i);
+    }
+    return *this;
+  }
+
+  constexpr T &x() { return values_[0]; }
+  constexpr T &y() { return values_[1]; }
+  constexpr T &z() { return values_[2]; }
+  constexpr const T &x() const { return values_[0]; }
+  constexpr const T &y() const { return values_[1]; }
+  constexpr const T &z() const { return values_[2]; }
+
+  constexpr T &operator[](const int index) {
+    detail::checkIndex(index);
+    return values_[index];
+  }
+  constexpr const T &operator[](const int index) const {
+    detail::checkIndex(index);
+    return values_[index];
+  }
+
+  // Unchecked access, for code that already knows its indices are in range.
+  constexpr T &atUnchecked(const int index) { return values_[index]; }
+  constexpr const T &atUnchecked(const int index) const {
+    return values_[index];
+  }
+  template <int I>
+  constexpr T &get() {
+    static_assert((I >= 0) && (I < 3), "Vector3 index out of range");
+    return values_[I];
+  }
+  template <int I>
+  constexpr const T &get() const {
+    static_assert((I >= 0) && (I < 3), "Vector3 index out of range");
+    return values_[I];
+  }
+  constexpr T *data() { return values_; }
+  constexpr const T *data() const { return values_; }
+
+  constexpr T element(const int index) const { return values_[index]; }
+
+  template <typename E>
+  constexpr BasicVector3 &operator+=(const VectorExpression<E> &rhs) {
+    return *this = *this + rhs;
+  }
+  template <typename E>
+  constexpr BasicVector3 &operator-=(const VectorExpression<E> &rhs) {
+    return *this = *this - rhs;
+  }
+  template <typename E>
+  constexpr BasicVector3 &operator*=(const VectorExpression<E> &rhs) {
+    return *this = *this * rhs;
+  }
+  template <typename E>
+  constexpr BasicVector3 &operator/=(const VectorExpression<E> &rhs) {
+    return *this = *this / rhs;
+  }
+  constexpr BasicVector3 &operator*=(const T rhs);
+  constexpr BasicVector3 &operator/=(const T rhs);
+
+  constexpr T dot(const BasicVector3 &rhs) const {
+    return values_[0] * rhs.values_[0] + values_[1] * rhs.values_[1] +
+           values_[2] * rhs.values_[2];
+  }
+  constexpr BasicVector3 cross(const BasicVector3 &rhs) const {
+    return BasicVector3{
+        values_[1] * rhs.values_[2] - values_[2] * rhs.values_[1],
+        values_[2] * rhs.values_[0] - values_[0] * rhs.values_[2],
+        values_[0] * rhs.values_[1] - values_[1] * rhs.values_[0]};
+  }
+  T norm() const;
+
+  // Same vector in another scalar type.
+  template <typename U>
+  constexpr BasicVector3<U> cast() const {
+    return BasicVector3<U>{static_cast<U>(values_[0]),
+                           static_cast<U>(values_[1]),
+                           static_cast<U>(values_[2])};
+  }
+
+ private:
+  T values_[3];
+};
+
+template <typename Lhs, typename Rhs>
+constexpr VectorBinaryExpression<Lhs, Rhs, detail::Add> operator+(
+    const VectorExpression<Lhs> &lhs, const VectorExpression<Rhs> &rhs) {
+  return VectorBinaryExpression<Lhs, Rhs, detail::Add>(
+      static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+constexpr VectorBinaryExpression<Lhs, Rhs, detail::Subtract> operator-(
+    const VectorExpression<Lhs> &lhs, const VectorExpression<Rhs> &rhs) {
+  return VectorBinaryExpression<Lhs, Rhs, detail::Subtract>(
+      static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+constexpr VectorBinaryExpression<Lhs, Rhs, detail::Multiply> operator*(
+    const VectorExpression<Lhs> &lhs, const VectorExpression<Rhs> &rhs) {
+  return VectorBinaryExpression<Lhs, Rhs, detail::Multiply>(
+      static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+constexpr VectorBinaryExpression<Lhs, Rhs, detail::Divide> operator/(
+    const VectorExpression<Lhs> &lhs, const VectorExpression<Rhs> &rhs) {
+  return VectorBinaryExpression<Lhs, Rhs, detail::Divide>(
+      static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename E>
+constexpr VectorScalarExpression<E, detail::Multiply> operator*(
+    const VectorExpression<E> &lhs, const typename E::Scalar rhs) {
+  return VectorScalarExpression<E, detail::Multiply>(
+      static_cast<const E &>(lhs), rhs);
+}
+
+template <typename E>
+constexpr VectorScalarExpression<E, detail::Multiply> operator*(
+    const typename E::Scalar lhs, const VectorExpression<E> &rhs) {
+  return VectorScalarExpression<E, detail::Multiply>(
+      static_cast<const E &>(rhs), lhs);
+}
+
+template <typename E>
+constexpr VectorScalarExpression<E, detail::Divide> operator/(
+    const VectorExpression<E> &lhs, const typename E::Scalar rhs) {
+  return VectorScalarExpression<E, detail::Divide>(
+      static_cast<const E &>(lhs), rhs);
+}
+
+template <typename Lhs, typename Rhs>
+constexpr bool operator==(const VectorExpression<Lhs> &lhs,
+                const VectorExpression<Rhs> &rhs) {
+  for (int i = 0; i < 3; ++i) {
+    if (!detail::almostEqual(lhs.element(i), rhs.element(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Lhs, typename Rhs>
+constexpr bool operator!=(const VectorExpression<Lhs> &lhs,
+                const VectorExpression<Rhs> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename E>
+constexpr auto VectorExpression<E>::eval() const {
+  return BasicVector3<typename E::Scalar>(*this);
+}
+
+template <typename T>
+inline constexpr BasicVector3<T> BasicVector3<T>::kUnitX{1, 0, 0};
+template <typename T>
+inline constexpr BasicVector3<T> BasicVector3<T>::kUnitY{0, 1, 0};
+template <typename T>
+inline constexpr BasicVector3<T> BasicVector3<T>::kUnitZ{0, 0, 1};
+template <typename T>
+inline constexpr BasicVector3<T> BasicVector3<T>::kZero{0, 0, 0};
+
+template <typename T>
+constexpr BasicVector3<T> &BasicVector3<T>::operator*=(const T rhs) {
+  return *this = *this * rhs;
+}
+
+template <typename T>
+constexpr BasicVector3<T> &BasicVector3<T>::operator/=(const T rhs) {
+  return *this = *this / rhs;
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const BasicVector3<T> &v);
+
+template <typename E>
+std::ostream &operator<<(std::ostream &os, const VectorExpression<E> &v) {
+  return os << v.eval();
+}
+
+// Base of all the lazily evaluated element-wise matrix expressions.
+template <typename E>
+class MatrixExpression {
+ public:
+  constexpr auto element(const int row, const int col) const {
+    return static_cast<const E &>(*this).element(row, col);
+  }
+
+  // Evaluates the expression, e.g. to call Matrix3 members on the result.
+  constexpr auto eval() const;
+
+ protected:
+  constexpr MatrixExpression() = default;
+};
+
+template <typename Lhs, typename Rhs, typename Op>
+class MatrixBinaryExpression
+    : public MatrixExpression<MatrixBinaryExpression<Lhs, Rhs, Op>> {
+ public:
+  typedef typename detail::CommonScalar<Lhs, Rhs>::type Scalar;
+
+  constexpr MatrixBinaryExpression(const Lhs &lhs, const Rhs &rhs)
+      : lhs_(lhs), rhs_(rhs) {}
+
+  constexpr Scalar element(const int row, const int col) const {
+    return Op::apply(lhs_.element(row, col), rhs_.element(row, col));
+  }
+
+ private:
+  typename detail::Nested<Lhs>::type lhs_;
+  typename detail::Nested<Rhs>::type rhs_;
+};
+
+template <typename E, typename Op>
+class MatrixScalarExpression
+    : public MatrixExpression<MatrixScalarExpression<E, Op>> {
+ public:
+  typedef typename E::Scalar Scalar;
+
+  constexpr MatrixScalarExpression(const E &expression, const Scalar scalar)
+      : expression_(expression), scalar_{scalar} {}
+
+  constexpr Scalar element(const int row, const int col) const {
+    return Op::apply(expression_.element(row, col), scalar_);
+  }
+
+ private:
+  typename detail::Nested<E>::type expression_;
+  const Scalar scalar_;
+};
+
+// 3x3 matrix, stored as three row vectors. The arithmetic operators between
+// two matrices are element-wise; use product() for the matrix product.
+template <typename T>
+class BasicMatrix3 : public MatrixExpression<BasicMatrix3<T>> {
+ public:
+  typedef T Scalar;
+
+  static const BasicMatrix3 kIdentity;
+  static const BasicMatrix3 kOnes;
+  static const BasicMatrix3 kZero;
+
+  constexpr BasicMatrix3() = default;
+  constexpr BasicMatrix3(const BasicVector3<T> &row0,
+                         const BasicVector3<T> &row1,
+                         const BasicVector3<T> &row2)
+      : rows_{row0, row1, row2} {}
+  constexpr BasicMatrix3(std::initializer_list<T> values) {
+    if (values.size() != 9) {
+      throw std::invalid_argument("A Matrix3 must be built from nine values");
+    }
+    const T *it{values.begin()};
+    for (BasicVector3<T> &row : rows_) {
+      row = BasicVector3<T>{it[0], it[1], it[2]};
+      it += 3;
+    }
+  }
+  // Expressions of other scalar types need an explicit cast().
+  template <typename E>
+    requires std::is_same_v<typename E::Scalar, T>
+  constexpr BasicMatrix3(  // NOLINT(runtime/explicit)
+      const MatrixExpression<E> &expression) {
+    *this = expression;
+  }
+
+  template <typename E>
+    requires std::is_same_v<typename E::Scalar, T>
+  constexpr BasicMatrix3 &operator=(const MatrixExpression<E> &expression) {
+    // Expressions are element-wise, so evaluating in place is alias-safe.
+    for (int i = 0; i < 3; ++i) {
+      rows_[i] = BasicVector3<T>{expression.element(i, 0),
+                                 expression.element(i, 1),
+                                 expression.element(i, 2)};
+    }
+    return *this;
+  }
+
+  constexpr BasicVector3<T> &operator[](const int index) {
+    detail::checkIndex(index);
+    return rows_[index];
+  }
+  constexpr const BasicVector3<T> &operator[](const int index) const {
+    detail::checkIndex(index);
+    return rows_[index];
+  }
+
+  // Unchecked access, for code that already knows its indices are in range.
+  // data() sees the matrix as nine contiguous scalars in row-major order.
+  constexpr BasicVector3<T> &atUnchecked(const int index) {
+    return rows_[index];
+  }
+  constexpr const BasicVector3<T> &atUnchecked(const int index) const {
+    return rows_[index];
+  }
+  constexpr T &atUnchecked(const int row, const int col) {
+    return rows_[row].atUnchecked(col);
+  }
+  constexpr const T &atUnchecked(const int row, const int col) const {
+    return rows_[row].atUnchecked(col);
+  }
+  template <int I>
+  constexpr BasicVector3<T> &get() {
+    static_assert((I >= 0) && (I < 3), "Matrix3 row index out of range");
+    return rows_[I];
+  }
+  template <int I>
+  constexpr const BasicVector3<T> &get() const {
+    static_assert((I >= 0) && (I < 3), "Matrix3 row index out of range");
+    return rows_[I];
+  }
+  constexpr T *data() { return rows_[0].data(); }
+  constexpr const T *data() const { return rows_[0].data(); }
+
+  constexpr T element(const int row, const int col) const {
+    return rows_[row].atUnchecked(col);
+  }
+
+  constexpr BasicVector3<T> row(const int index) const {
+    return (*this)[index];
+  }
+  constexpr BasicVector3<T> col(const int index) const {
+    detail::checkIndex(index);
+    return BasicVector3<T>{rows_[0].atUnchecked(index),
+                           rows_[1].atUnchecked(index),
+                           rows_[2].atUnchecked(index)};
+  }
+
+  template <typename E>
+  constexpr BasicMatrix3 &operator+=(const MatrixExpression<E> &rhs) {
+    return *this = *this + rhs;
+  }
+  template <typename E>
+  constexpr BasicMatrix3 &operator-=(const MatrixExpression<E> &rhs) {
+    return *this = *this - rhs;
+  }
+  template <typename E>
+  constexpr BasicMatrix3 &operator*=(const MatrixExpression<E> &rhs) {
+    return *this = *this * rhs;
+  }
+  template <typename E>
+  constexpr BasicMatrix3 &operator/=(const MatrixExpression<E> &rhs) {
+    return *this = *this / rhs;
+  }
+  constexpr BasicMatrix3 &operator*=(const T rhs);
+  constexpr BasicMatrix3 &operator/=(const T rhs);
+
+  // Matrix product. Evaluated with the dispatched product kernels at run
+  // time for doubles, which yield the same bits as the constant-evaluated
+  // loop.
+  constexpr BasicMatrix3 product(const BasicMatrix3 &rhs) const;
+  constexpr BasicMatrix3 transpose() const {
+    return BasicMatrix3{col(0), col(1), col(2)};
+  }
+  // General inverse. Throws std::domain_error on singular matrices. The
+  // inverse of a rotation is its transpose, which is much cheaper.
+  constexpr BasicMatrix3 inverse() const;
+  constexpr T det() const {
+    ISOMETRY_INSTRUMENT(kMatrix3Det);
+    return rows_[0].dot(rows_[1].cross(rows_[2]));
+  }
+
+  // Transpose of the matrix times |v|, without materializing the transpose.
+  // For rotations that is |v| rotated by the inverse rotation.
+  constexpr BasicVector3<T> transposeProduct(const BasicVector3<T> &v) const {
+    return v.x() * rows_[0] + v.y() * rows_[1] + v.z() * rows_[2];
+  }
+
+  // Default tolerance of isRotation().
+  static constexpr T kRotationTolerance{1024 *
+                                        std::numeric_limits<T>::epsilon()};
+
+  // Drift off orthonormality: the largest deviation of an element of M M'
+  // from the identity. Six dot products, cheap enough to check often.
+  constexpr T orthonormalityError() const {
+    const T deviations[6] = {
+        detail::absolute(rows_[0].dot(rows_[0]) - T{1}),
+        detail::absolute(rows_[1].dot(rows_[1]) - T{1}),
+        detail::absolute(rows_[2].dot(rows_[2]) - T{1}),
+        detail::absolute(rows_[0].dot(rows_[1])),
+        detail::absolute(rows_[0].dot(rows_[2])),
+        detail::absolute(rows_[1].dot(rows_[2]))};
+    // The sum only serves to propagate NaN, which max() would drop.
+    const T sum{(deviations[0] + deviations[1]) +
+                (deviations[2] + deviations[3]) +
+                (deviations[4] + deviations[5])};
+    const T error{std::max({deviations[0], deviations[1], deviations[2],
+                            deviations[3], deviations[4], deviations[5]})};
+    return sum == sum ? error : sum;
+  }
+
+  // Whether this is a proper rotation: orthonormal, so that M M' = I within
+  // |tolerance| per element, and with a positive determinant.
+  constexpr bool isRotation(const T tolerance = kRotationTolerance) const {
+    return (orthonormalityError() <= tolerance) && (det() > T{0});
+  }
+
+  // Closest orthonormal matrix, for rotations that have drifted off
+  // orthonormality, e.g. through long chains of products. Each Newton-Schulz
+  // step of the polar decomposition, M <- (3 I - M M') M / 2, roughly squares
+  // the error and, unlike Gram-Schmidt, treats all the rows alike. Drift
+  // from rounding takes a single step, and orthonormal matrices none. Throws
+  // std::domain_error if orthonormalityError() is 1/3 or more, too far for
+  // the steps to be guaranteed to converge.
+  constexpr BasicMatrix3 orthonormalized() const;
+
+  // Skew-symmetric matrix of |v|, the one for which hat(v) * u is
+  // v.cross(u).
+  static constexpr BasicMatrix3 hat(const BasicVector3<T> &v) {
+    return BasicMatrix3{T{0},  -v.z(), v.y(),  v.z(), T{0},
+                        -v.x(), -v.y(), v.x(), T{0}};
+  }
+  // Inverse of hat(): the vector of the skew-symmetric part of the matrix.
+  constexpr BasicVector3<T> vee() const {
+    return BasicVector3<T>{
+        (rows_[2].atUnchecked(1) - rows_[1].atUnchecked(2)) / T{2},
+        (rows_[0].atUnchecked(2) - rows_[2].atUnchecked(0)) / T{2},
+        (rows_[1].atUnchecked(0) - rows_[0].atUnchecked(1)) / T{2}};
+  }
+
+  // Exponential map of SO(3): rotation of |rotation_vector|.norm() radians
+  // around |rotation_vector|, the identity for a null vector. Small angles
+  // take a Taylor series instead of trigonometric functions.
+  static BasicMatrix3 exp(const BasicVector3<T> &rotation_vector);
+  // Logarithm map of SO(3), inverse of exp(): the rotation vector of this
+  // rotation, with its norm, the angle, in [0, pi]. At pi either of the two
+  // opposite rotation vectors may be returned. The matrix is assumed to be a
+  // rotation, see isRotation().
+  BasicVector3<T> log() const;
+
+  // Same matrix in another scalar type.
+  template <typename U>
+  constexpr BasicMatrix3<U> cast() const {
+    return BasicMatrix3<U>{rows_[0].template cast<U>(),
+                           rows_[1].template cast<U>(),
+                           rows_[2].template cast<U>()};
+  }
+
+  friend constexpr BasicVector3<T> operator*(const BasicMatrix3 &lhs,
+                                             const BasicVector3<T> &rhs) {
+    if constexpr (std::is_same_v<T, double>) {
+      if (!std::is_constant_evaluated()) {
+        return detail::productKernel(lhs, rhs);
+      }
+    }
+    return BasicVector3<T>{lhs.rows_[0].dot(rhs), lhs.rows_[1].dot(rhs),
+                           lhs.rows_[2].dot(rhs)};
+  }
+
+ private:
+  BasicMatrix3 productKernel(const BasicMatrix3 &rhs) const
+    requires std::is_same_v<T, double>;
+
+  BasicVector3<T> rows_[3];
+};
+
+template <typename Lhs, typename Rhs>
+constexpr MatrixBinaryExpression<Lhs, Rhs, detail::Add> operator+(
+    const MatrixExpression<Lhs> &lhs, const MatrixExpression<Rhs> &rhs) {
+  return MatrixBinaryExpression<Lhs, Rhs, detail::Add>(
+      static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+constexpr MatrixBinaryExpression<Lhs, Rhs, detail::Subtract> operator-(
+    const MatrixExpression<Lhs> &lhs, const MatrixExpression<Rhs> &rhs) {
+  return MatrixBinaryExpression<Lhs, Rhs, detail::Subtract>(
+      static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+constexpr MatrixBinaryExpression<Lhs, Rhs, detail::Multiply> operator*(
+    const MatrixExpression<Lhs> &lhs, const MatrixExpression<Rhs> &rhs) {
+  return MatrixBinaryExpression<Lhs, Rhs, detail::Multiply>(
+      static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+constexpr MatrixBinaryExpression<Lhs, Rhs, detail::Divide> operator/(
+    const MatrixExpression<Lhs> &lhs, const MatrixExpression<Rhs> &rhs) {
+  return MatrixBinaryExpression<Lhs, Rhs, detail::Divide>(
+      static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename E>
+constexpr MatrixScalarExpression<E, detail::Multiply> operator*(
+    const MatrixExpression<E> &lhs, const typename E::Scalar rhs) {
+  return MatrixScalarExpression<E, detail::Multiply>(
+      static_cast<const E &>(lhs), rhs);
+}
+
+template <typename E>
+constexpr MatrixScalarExpression<E, detail::Multiply> operator*(
+    const typename E::Scalar lhs, const MatrixExpression<E> &rhs) {
+  return MatrixScalarExpression<E, detail::Multiply>(
+      static_cast<const E &>(rhs), lhs);
+}
+
+template <typename E>
+constexpr MatrixScalarExpression<E, detail::Divide> operator/(
+    const MatrixExpression<E> &lhs, const typename E::Scalar rhs) {
+  return MatrixScalarExpression<E, detail::Divide>(
+      static_cast<const E &>(lhs), rhs);
+}
+
+template <typename Lhs, typename Rhs>
+constexpr bool operator==(const MatrixExpression<Lhs> &lhs,
+                const MatrixExpression<Rhs> &rhs) {
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      if (!detail::almostEqual(lhs.element(i, j), rhs.element(i, j))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename Lhs, typename Rhs>
+constexpr bool operator!=(const MatrixExpression<Lhs> &lhs,
+                const MatrixExpression<Rhs> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename E>
+constexpr auto MatrixExpression<E>::eval() const {
+  return BasicMatrix3<typename E::Scalar>(*this);
+}
+
+template <typename T>
+inline constexpr BasicMatrix3<T> BasicMatrix3<T>::kIdentity{1, 0, 0, 0, 1,
+                                                          0, 0, 0, 1};
+template <typename T>
+inline constexpr BasicMatrix3<T> BasicMatrix3<T>::kOnes{1, 1, 1, 1, 1,
+                                                      1, 1, 1, 1};
+template <typename T>
+inline constexpr BasicMatrix3<T> BasicMatrix3<T>::kZero{0, 0, 0, 0, 0,
+                                                      0, 0, 0, 0};
+
+template <typename T>
+constexpr BasicMatrix3<T> &BasicMatrix3<T>::operator*=(const T rhs) {
+  return *this = *this * rhs;
+}
+
+template <typename T>
+constexpr BasicMatrix3<T> &BasicMatrix3<T>::operator/=(const T rhs) {
+  return *this = *this / rhs;
+}
+
+template <typename T>
+constexpr BasicMatrix3<T> BasicMatrix3<T>::product(
+    const BasicMatrix3 &rhs) const {
+  if constexpr (std::is_same_v<T, double>) {
+    if (!std::is_constant_evaluated()) {
+      return productKernel(rhs);
+    }
+  }
+  BasicMatrix3 result;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      result.atUnchecked(i, j) =
+          atUnchecked(i, 0) * rhs.atUnchecked(0, j) +
+          atUnchecked(i, 1) * rhs.atUnchecked(1, j) +
+          atUnchecked(i, 2) * rhs.atUnchecked(2, j);
+    }
+  }
+  return result;
+}
+
+template <typename T>
+constexpr BasicMatrix3<T> BasicMatrix3<T>::inverse() const {
+  const T determinant{det()};
+  if (determinant == T{0}) {
+    throw std::domain_error("Singular matrices can't be inverted");
+  }
+  // The rows of the cofactor matrix are the cross products of the rows of
+  // the original matrix, and the inverse is its scaled transpose.
+  const BasicMatrix3 cofactors{rows_[1].cross(rows_[2]),
+                               rows_[2].cross(rows_[0]),
+                               rows_[0].cross(rows_[1])};
+  return cofactors.transpose() / determinant;
+}
+
+template <typename T>
+constexpr BasicMatrix3<T> BasicMatrix3<T>::orthonormalized() const {
+  // An error below 1/3 per element bounds the spectral norm of I - M M'
+  // below one, where the steps converge to the closest orthonormal matrix.
+  constexpr T kMaxError{T{1} / T{3}};
+  // Rounding leaves a few epsilon of error after the last step.
+  constexpr T kTolerance{8 * std::numeric_limits<T>::epsilon()};
+  constexpr int kMaxSteps{8};
+  if (!(orthonormalityError() < kMaxError)) {
+    throw std::domain_error("The matrix is too far from orthonormal");
+  }
+  BasicMatrix3 result{*this};
+  for (int step = 0; step < kMaxSteps; ++step) {
+    if (result.orthonormalityError() <= kTolerance) {
+      break;
+    }
+    // Rows of (3 I - M M') M / 2, with M M' symmetric.
+    const BasicVector3<T> &r0{result.rows_[0]};
+    const BasicVector3<T> &r1{result.rows_[1]};
+    const BasicVector3<T> &r2{result.rows_[2]};
+    const T g01{r0.dot(r1)};
+    const T g02{r0.dot(r2)};
+    const T g12{r1.dot(r2)};
+    result = BasicMatrix3{
+        T{1.5} * r0 - T{0.5} * (r0.dot(r0) * r0 + g01 * r1 + g02 * r2),
+        T{1.5} * r1 - T{0.5} * (g01 * r0 + r1.dot(r1) * r1 + g12 * r2),
+        T{1.5} * r2 - T{0.5} * (g02 * r0 + g12 * r1 + r2.dot(r2) * r2)};
+  }
+  return result;
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const BasicMatrix3<T> &m);
+
+template <typename E>
+std::ostream &operator<<(std::ostream &os, const MatrixExpression<E> &m) {
+  return os << m.eval();
+}
+
+// Structure-of-arrays container of points, meant to be pushed through an
+// isometry in bulk. Each coordinate is kept in its own contiguous array,
+// allocated from the memory resource given on construction. Copies use the
+// default resource, like the std::pmr containers.
+class Vector3Batch {
+ public:
+  Vector3Batch() = default;
+  explicit Vector3Batch(std::pmr::memory_resource *resource)
+      : x_(resource), y_(resource), z_(resource) {}
+  explicit Vector3Batch(
+      const std::size_t size,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : x_(size, resource), y_(size, resource), z_(size, resource) {}
+
+  std::size_t size() const { return x_.size(); }
+  bool empty() const { return x_.empty(); }
+  void resize(const std::size_t size);
+  void reserve(const std::size_t capacity);
+  void clear();
+  void push_back(const Vector3 &point);
+
+  Vector3 get(const std::size_t index) const;
+  void set(const std::size_t index, const Vector3 &point);
+
+  double *x() { return x_.data(); }
+  double *y() { return y_.data(); }
+  double *z() { return z_.data(); }
+  const double *x() const { return x_.data(); }
+  const double *y() const { return y_.data(); }
+  const double *z() const { return z_.data(); }
+
+  std::pmr::memory_resource *resource() const {
+    return x_.get_allocator().resource();
+  }
+
+ private:
+  std::pmr::vector<double> x_;
+  std::pmr::vector<double> y_;
+  std::pmr::vector<double> z_;
+};
+
+// Euler angle conventions: the axes of three elementary rotations, by the
+// first, second and third angles in turn, taken either about the axes of
+// the frame as it rotates (intrinsic) or about those of the fixed frame
+// (extrinsic). Intrinsic rotations about X, Y and Z compose as
+// Rx * Ry * Rz, and extrinsic ones as Rz * Ry * Rx, so every extrinsic
+// convention is an intrinsic one with the axes and angles reversed.
+enum class EulerConvention {
+  kIntrinsicXYZ,
+  kIntrinsicZYX,
+  kIntrinsicZYZ,
+  kExtrinsicXYZ,
+  kExtrinsicZYX,
+  kExtrinsicZYZ,
+};
+
+namespace detail {
+
+constexpr bool isExtrinsic(const EulerConvention convention) {
+  return (convention == EulerConvention::kExtrinsicXYZ) ||
+         (convention == EulerConvention::kExtrinsicZYX) ||
+         (convention == EulerConvention::kExtrinsicZYZ);
+}
+
+// Intrinsic convention equivalent to the extrinsic |convention| with its
+// angles reversed.
+constexpr EulerConvention reversed(const EulerConvention convention) {
+  switch (convention) {
+    case EulerConvention::kExtrinsicXYZ:
+      return EulerConvention::kIntrinsicZYX;
+    case EulerConvention::kExtrinsicZYX:
+      return EulerConvention::kIntrinsicXYZ;
+    default:
+      return EulerConvention::kIntrinsicZYZ;
+  }
+}
+
+// Product of the three elementary rotations of |Convention|, multiplied out
+// from the sines and cosines of the angles.
+template <EulerConvention Convention, typename T>
+constexpr BasicMatrix3<T> eulerRotation(const T s1, const T c1, const T s2,
+                                        const T c2, const T s3, const T c3) {
+  if constexpr (isExtrinsic(Convention)) {
+    return eulerRotation<reversed(Convention)>(s3, c3, s2, c2, s1, c1);
+  } else if constexpr (Convention == EulerConvention::kIntrinsicXYZ) {
+    const T s1_s2{s1 * s2};
+    const T c1_s2{c1 * s2};
+    return BasicMatrix3<T>{c2 * c3,
+                           -c2 * s3,
+                           s2,
+                           c1 * s3 + s1_s2 * c3,
+                           c1 * c3 - s1_s2 * s3,
+                           -s1 * c2,
+                           s1 * s3 - c1_s2 * c3,
+                           s1 * c3 + c1_s2 * s3,
+                           c1 * c2};
+  } else if constexpr (Convention == EulerConvention::kIntrinsicZYX) {
+    const T c1_s2{c1 * s2};
+    const T s1_s2{s1 * s2};
+    return BasicMatrix3<T>{c1 * c2,
+                           c1_s2 * s3 - s1 * c3,
+                           c1_s2 * c3 + s1 * s3,
+                           s1 * c2,
+                           s1_s2 * s3 + c1 * c3,
+                           s1_s2 * c3 - c1 * s3,
+                           -s2,
+                           c2 * s3,
+                           c2 * c3};
+  } else {
+    static_assert(Convention == EulerConvention::kIntrinsicZYZ);
+    const T c1_c2{c1 * c2};
+    const T s1_c2{s1 * c2};
+    return BasicMatrix3<T>{c1_c2 * c3 - s1 * s3,
+                           -c1_c2 * s3 - s1 * c3,
+                           c1 * s2,
+                           s1_c2 * c3 + c1 * s3,
+                           -s1_c2 * s3 + c1 * c3,
+                           s1 * s2,
+                           -s2 * c3,
+                           s2 * s3,
+                           c2};
+  }
+}
+
+// Angles of |Convention| for rotation |r|. The first and second come from a
+// row or a column of |r|. The third is then solved for from the first, which
+// keeps it exact in gimbal lock, where the first is arbitrary.
+template <EulerConvention Convention, typename T>
+std::array<T, 3> eulerAngles(const BasicMatrix3<T> &r) {
+  if constexpr (isExtrinsic(Convention)) {
+    const std::array<T, 3> angles{eulerAngles<reversed(Convention)>(r)};
+    return std::array<T, 3>{angles[2], angles[1], angles[0]};
+  } else if constexpr (Convention == EulerConvention::kIntrinsicXYZ) {
+    // Rx(1)' R = Ry(2) Rz(3), whose second row is (s3, c3, 0).
+    const T first{std::atan2(-r.element(1, 2), r.element(2, 2))};
+    const T c2{std::sqrt(r.element(0, 0) * r.element(0, 0) +
+                         r.element(0, 1) * r.element(0, 1))};
+    const T s1{std::sin(first)};
+    const T c1{std::cos(first)};
+    return std::array<T, 3>{
+        first, std::atan2(r.element(0, 2), c2),
+        std::atan2(c1 * r.element(1, 0) + s1 * r.element(2, 0),
+                   c1 * r.element(1, 1) + s1 * r.element(2, 1))};
+  } else if constexpr (Convention == EulerConvention::kIntrinsicZYX) {
+    // Rz(1)' R = Ry(2) Rx(3), whose second row is (0, c3, -s3).
+    const T first{std::atan2(r.element(1, 0), r.element(0, 0))};
+    const T c2{std::sqrt(r.element(0, 0) * r.element(0, 0) +
+                         r.element(1, 0) * r.element(1, 0))};
+    const T s1{std::sin(first)};
+    const T c1{std::cos(first)};
+    return std::array<T, 3>{
+        first, std::atan2(-r.element(2, 0), c2),
+        std::atan2(s1 * r.element(0, 2) - c1 * r.element(1, 2),
+                   c1 * r.element(1, 1) - s1 * r.element(0, 1))};
+  } else {
+    static_assert(Convention == EulerConvention::kIntrinsicZYZ);
+    // Rz(1)' R = Ry(2) Rz(3), whose second row is (s3, c3, 0).
+    const T first{std::atan2(r.element(1, 2), r.element(0, 2))};
+    const T s2{std::sqrt(r.element(0, 2) * r.element(0, 2) +
+                         r.element(1, 2) * r.element(1, 2))};
+    const T s1{std::sin(first)};
+    const T c1{std::cos(first)};
+    return std::array<T, 3>{
+        first, std::atan2(s2, r.element(2, 2)),
+        std::atan2(c1 * r.element(1, 0) - s1 * r.element(0, 0),
+                   c1 * r.element(1, 1) - s1 * r.element(0, 1))};
+  }
+}
+
+}  // namespace detail
+
+// Element of se(3), the tangent space of rigid transformations: a linear
+// and an angular velocity, in the frame of the start of the motion, held
+// for unit time. BasicIsometry::exp() and log() map between twists and
+// isometries, e.g. to interpolate between two poses along a screw motion.
+template <typename T>
+struct BasicTwist {
+  BasicVector3<T> linear;
+  BasicVector3<T> angular;
+
+  constexpr bool operator==(const BasicTwist &rhs) const {
+    return (linear == rhs.linear) && (angular == rhs.angular);
+  }
+  constexpr bool operator!=(const BasicTwist &rhs) const {
+    return !(*this == rhs);
+  }
+};
+
+// Rigid transformation between two coordinate frames.
+template <typename T>
+class BasicIsometry {
+ public:
+  typedef T Scalar;
+
+  constexpr BasicIsometry() = default;
+  constexpr BasicIsometry(const BasicVector3<T> &translation,
+                          const BasicMatrix3<T> &rotation)
+      : translation_{translation}, rotation_{rotation} {}
+
+  static constexpr BasicIsometry fromTranslation(
+      const BasicVector3<T> &translation) {
+    return BasicIsometry{translation, BasicMatrix3<T>::kIdentity};
+  }
+  static BasicIsometry rotateAround(const BasicVector3<T> &axis,
+                                    const T angle);
+  // Rotation about X by |roll|, then about the rotated Y by |pitch|, then
+  // about the rotated Z by |yaw|: fromEulerAngles<kIntrinsicXYZ>().
+  static BasicIsometry fromEulerAngles(const T roll, const T pitch,
+                                       const T yaw);
+  // Rotation of the |first|, |second| and |third| angles of |Convention|,
+  // built in closed form from their sines and cosines.
+  template <EulerConvention Convention>
+  static BasicIsometry fromEulerAngles(const T first, const T second,
+                                       const T third);
+  // Angles of |Convention| that build the rotation, inverse of
+  // fromEulerAngles(). The second angle is in [-pi/2, pi/2] for XYZ and ZYX,
+  // and in [0, pi] for ZYZ, the others in [-pi, pi]. In gimbal lock, when
+  // the first and third axes line up, the first angle is arbitrary and the
+  // third makes up for it. The rotation is assumed to be orthonormal.
+  template <EulerConvention Convention = EulerConvention::kIntrinsicXYZ>
+  std::array<T, 3> toEulerAngles() const {
+    return detail::eulerAngles<Convention>(rotation_);
+  }
+  // Batch forms, for streams of angles such as joint encoder readings:
+  // isometries[i] is built from the i-th angles. Sines and cosines come from
+  // the vectorized kernel, see kernels::SinCosKernel, so results may differ
+  // from those of the single forms by a few ulps. Throw
+  // std::invalid_argument if the sizes differ or |axis| is a null vector.
+  static void rotateAround(const BasicVector3<T> &axis,
+                           std::span<const T> angles,
+                           std::span<BasicIsometry> isometries)
+    requires std::is_same_v<T, double>;
+  static void fromEulerAngles(std::span<const T> roll,
+                              std::span<const T> pitch,
+                              std::span<const T> yaw,
+                              std::span<BasicIsometry> isometries)
+    requires std::is_same_v<T, double>;
+
+  // Exponential map of SE(3): the isometry reached by holding |twist| for
+  // unit time, with the rotation of BasicMatrix3::exp(twist.angular).
+  static BasicIsometry exp(const BasicTwist<T> &twist);
+  // isometries[i] = exp(twists[i]). Throws std::invalid_argument if the
+  // sizes differ.
+  static void exp(std::span<const BasicTwist<T>> twists,
+                  std::span<BasicIsometry> isometries);
+  // Logarithm map of SE(3), inverse of exp(), see BasicMatrix3::log(). The
+  // isometry is assumed to be rigid, see isRigid().
+  BasicTwist<T> log() const;
+  // twists[i] = isometries[i].log(). Throws std::invalid_argument if the
+  // sizes differ.
+  static void log(std::span<const BasicIsometry> isometries,
+                  std::span<BasicTwist<T>> twists);
+
+  constexpr const BasicVector3<T> &translation() const {
+    return translation_;
+  }
+  constexpr const BasicMatrix3<T> &rotation() const { return rotation_; }
+
+  constexpr BasicVector3<T> transform(const BasicVector3<T> &point) const {
+    return rotation_ * point + translation_;
+  }
+  // Transforms every point in |input| into |output|, resizing it as needed.
+  void transform(const Vector3Batch &input, Vector3Batch &output) const
+    requires std::is_same_v<T, double>;
+  // Transforms every point in |points| in place.
+  void transform(Vector3Batch &points) const
+    requires std::is_same_v<T, double>;
+
+  constexpr BasicIsometry compose(const BasicIsometry &rhs) const {
+    ISOMETRY_INSTRUMENT(kIsometryCompose);
+    return BasicIsometry{rotation_ * rhs.translation_ + translation_,
+                         rotation_.product(rhs.rotation_)};
+  }
+  // General inverse, valid for any invertible rotation matrix. Throws
+  // std::domain_error if it is singular.
+  constexpr BasicIsometry inverse() const {
+    ISOMETRY_INSTRUMENT(kIsometryInverse);
+    const BasicMatrix3<T> inverse_rotation{rotation_.inverse()};
+    return BasicIsometry{T{-1} * (inverse_rotation * translation_),
+                         inverse_rotation};
+  }
+
+  // Whether the rotation is a proper rotation matrix, see
+  // BasicMatrix3::isRotation(). Isometries built from translations, angles,
+  // and compositions and rigid inverses of those are rigid up to rounding.
+  constexpr bool isRigid(const T tolerance =
+                             BasicMatrix3<T>::kRotationTolerance) const {
+    return rotation_.isRotation(tolerance);
+  }
+
+  // Same isometry with its rotation orthonormalized, see
+  // BasicMatrix3::orthonormalized(). Throws std::domain_error if the rotation
+  // is too far from orthonormal.
+  constexpr BasicIsometry orthonormalized() const {
+    return BasicIsometry{translation_, rotation_.orthonormalized()};
+  }
+
+  // Inverse of a rigid isometry: the inverse rotation is the transpose, so
+  // no general 3x3 inversion is needed. The rotation is assumed to be
+  // orthonormal and is not checked, see isRigid().
+  constexpr BasicIsometry rigidInverse() const {
+    return BasicIsometry{T{-1} * rotation_.transposeProduct(translation_),
+                         rotation_.transpose()};
+  }
+
+  // rigidInverse() * point, without building the inverse.
+  constexpr BasicVector3<T> inverseTransform(
+      const BasicVector3<T> &point) const {
+    return rotation_.transposeProduct(point - translation_);
+  }
+
+  // Same isometry in another scalar type.
+  template <typename U>
+  constexpr BasicIsometry<U> cast() const {
+    return BasicIsometry<U>{translation_.template cast<U>(),
+                            rotation_.template cast<U>()};
+  }
+
+  constexpr BasicIsometry &operator*=(const BasicIsometry &rhs) {
+    return *this = compose(rhs);
+  }
+
+  constexpr bool operator==(const BasicIsometry &rhs) const {
+    return (translation_ == rhs.translation_) && (rotation_ == rhs.rotation_);
+  }
+  constexpr bool operator!=(const BasicIsometry &rhs) const {
+    return !(*this == rhs);
+  }
+
+  friend constexpr BasicIsometry operator*(const BasicIsometry &lhs,
+                                           const BasicIsometry &rhs) {
+    return lhs.compose(rhs);
+  }
+  friend constexpr BasicVector3<T> operator*(const BasicIsometry &lhs,
+                                             const BasicVector3<T> &rhs) {
+    return lhs.transform(rhs);
+  }
+
+ private:
+  BasicVector3<T> translation_;
+  BasicMatrix3<T> rotation_;
+};
+
+template <typename T>
+template <EulerConvention Convention>
+BasicIsometry<T> BasicIsometry<T>::fromEulerAngles(const T first,
+                                                   const T second,
+                                                   const T third) {
+  ISOMETRY_INSTRUMENT(kIsometryFromEulerAngles);
+  return BasicIsometry{
+      BasicVector3<T>::kZero,
+      detail::eulerRotation<Convention>(std::sin(first), std::cos(first),
+                                        std::sin(second), std::cos(second),
+                                        std::sin(third), std::cos(third))};
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const BasicIsometry<T> &t);
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const BasicTwist<T> &t);
 
 }  // namespace math
 
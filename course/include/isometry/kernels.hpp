@@ -0,0 +1,73 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace ekumen {
+
+namespace math {
+
+namespace kernels {
+
+// Instruction sets for which kernels are provided. The library picks the
+// best one the CPU supports the first time a kernel is used.
+enum class InstructionSet { kScalar, kSse2, kAvx2, kAvx512 };
+
+// Kernels operate on row-major 3x3 matrices and 3-vectors stored as plain
+// double arrays. The result must not alias any of the operands.
+//
+// All the variants accumulate each element as (a0 * b0 + a1 * b1) + a2 * b2
+// with no fused multiply-add, so their results are bit-identical to the
+// scalar kernel.
+//
+// Aligned kernels operate on the padded layout of AlignedMatrix3 and
+// AlignedVector3 instead: 32-byte aligned rows of four doubles, the last of
+// which is zero. They take the padding as zero and leave it zero in the
+// result, so rows are loaded and stored whole.
+using MatrixProductKernel = void (*)(const double *lhs, const double *rhs,
+                                     double *result);
+using MatrixVectorProductKernel = void (*)(const double *lhs,
+                                           const double *rhs, double *result);
+
+// Sines and cosines of |count| angles, for building rotations in bulk. Angles
+// up to kSinCosRange radians in magnitude are reduced to [-pi/4, pi/4] with
+// a four-part Cody-Waite reduction and evaluated with minimax polynomials,
+// lane by lane in the SIMD variants, with results within kSinCosMaxUlp ulps
+// of the exact ones. Larger or non-finite angles fall back to std::sin() and
+// std::cos(). As with the products, every variant yields the same bits.
+// |sines| and |cosines| must not alias |angles|.
+using SinCosKernel = void (*)(const double *angles, std::size_t count,
+                              double *sines, double *cosines);
+
+constexpr double kSinCosRange{1e6};
+constexpr double kSinCosMaxUlp{1.};
+
+struct KernelTable {
+  InstructionSet instruction_set;
+  MatrixProductKernel matrix_product;
+  MatrixVectorProductKernel matrix_vector_product;
+  MatrixProductKernel aligned_matrix_product;
+  MatrixVectorProductKernel aligned_matrix_vector_product;
+  SinCosKernel sincos;
+};
+
+// Whether both this build and the running CPU support |instruction_set|.
+bool isSupported(const InstructionSet instruction_set);
+
+// Kernels for a given instruction set. Throws std::invalid_argument if the
+// instruction set is not supported.
+KernelTable kernelsFor(const InstructionSet instruction_set);
+
+// Kernels used by the library, selected once on first use.
+const KernelTable &activeKernels();
+
+}  // namespace kernels
+
+}  // namespace math
+
+}  // namespace ekumen
@@ -0,0 +1,414 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Isometries with a known structure: a pure translation, a rotation around
+// one of the frame axes, and a rotation around z plus a translation. They
+// store only what their structure needs and compose with each other and with
+// BasicIsometry through dedicated overloads, e.g. composing two translations
+// is a single vector sum instead of a full 3x3 product. A composition whose
+// result leaves the structure of both operands returns a BasicIsometry; each
+// type also converts to one implicitly where a full isometry is needed.
+
+enum class Axis { kX, kY, kZ };
+
+namespace detail {
+
+// A rotation around |axis| turns the first coordinate returned here towards
+// the second one, and leaves the remaining one alone.
+constexpr int firstRotatedIndex(const Axis axis) {
+  return (static_cast<int>(axis) + 1) % 3;
+}
+constexpr int secondRotatedIndex(const Axis axis) {
+  return (static_cast<int>(axis) + 2) % 3;
+}
+
+// Rotation around |axis| of cosine |c| and sine |s|, times |m|. Only two
+// rows change, 12 multiplies.
+template <Axis A, typename T>
+constexpr BasicMatrix3<T> rotateRows(const T c, const T s,
+                                     const BasicMatrix3<T> &m) {
+  constexpr int kI{firstRotatedIndex(A)};
+  constexpr int kJ{secondRotatedIndex(A)};
+  BasicMatrix3<T> result{m};
+  for (int col = 0; col < 3; ++col) {
+    const T a{m.element(kI, col)};
+    const T b{m.element(kJ, col)};
+    result.atUnchecked(kI, col) = c * a - s * b;
+    result.atUnchecked(kJ, col) = s * a + c * b;
+  }
+  return result;
+}
+
+// |m| times the rotation around |axis| of cosine |c| and sine |s|. Only two
+// columns change, 12 multiplies.
+template <Axis A, typename T>
+constexpr BasicMatrix3<T> rotateColumns(const BasicMatrix3<T> &m, const T c,
+                                        const T s) {
+  constexpr int kI{firstRotatedIndex(A)};
+  constexpr int kJ{secondRotatedIndex(A)};
+  BasicMatrix3<T> result{m};
+  for (int row = 0; row < 3; ++row) {
+    const T a{m.element(row, kI)};
+    const T b{m.element(row, kJ)};
+    result.atUnchecked(row, kI) = c * a + s * b;
+    result.atUnchecked(row, kJ) = c * b - s * a;
+  }
+  return result;
+}
+
+}  // namespace detail
+
+// Translation with no rotation, as built by BasicIsometry::fromTranslation().
+template <typename T>
+class BasicTranslation3 {
+ public:
+  typedef T Scalar;
+
+  constexpr BasicTranslation3() = default;
+  constexpr explicit BasicTranslation3(const BasicVector3<T> &translation)
+      : translation_{translation} {}
+
+  constexpr const BasicVector3<T> &translation() const {
+    return translation_;
+  }
+
+  constexpr BasicVector3<T> transform(const BasicVector3<T> &point) const {
+    return point + translation_;
+  }
+  constexpr BasicTranslation3 inverse() const {
+    return BasicTranslation3{T{-1} * translation_};
+  }
+
+  constexpr BasicIsometry<T> toIsometry() const {
+    return BasicIsometry<T>::fromTranslation(translation_);
+  }
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  constexpr operator BasicIsometry<T>() const { return toIsometry(); }
+
+  constexpr BasicTranslation3 &operator*=(const BasicTranslation3 &rhs) {
+    translation_ += rhs.translation_;
+    return *this;
+  }
+
+  constexpr bool operator==(const BasicTranslation3 &rhs) const {
+    return translation_ == rhs.translation_;
+  }
+  constexpr bool operator!=(const BasicTranslation3 &rhs) const {
+    return !(*this == rhs);
+  }
+
+  friend constexpr BasicTranslation3 operator*(const BasicTranslation3 &lhs,
+                                               const BasicTranslation3 &rhs) {
+    return BasicTranslation3{lhs.translation_ + rhs.translation_};
+  }
+  friend constexpr BasicVector3<T> operator*(const BasicTranslation3 &lhs,
+                                             const BasicVector3<T> &rhs) {
+    return lhs.transform(rhs);
+  }
+
+ private:
+  BasicVector3<T> translation_;
+};
+
+// Rotation around one of the frame axes, as built by
+// BasicIsometry::rotateAround() with a unit axis. It keeps the cosine and
+// sine of the angle, so that rotations around the same axis compose with
+// four multiplies. Like rotation matrices, long chains of compositions drift
+// off unit norm; rebuilding from angle() brings them back.
+template <Axis A, typename T>
+class BasicAxisRotation {
+ public:
+  typedef T Scalar;
+
+  static constexpr Axis kAxis{A};
+
+  constexpr BasicAxisRotation() = default;
+  // Rotation of |angle| radians around the axis.
+  explicit BasicAxisRotation(const T angle)
+      : cos_{std::cos(angle)}, sin_{std::sin(angle)} {}
+
+  // Rotation whose angle has cosine |cos| and sine |sin|, which are assumed
+  // to have a unit norm.
+  static constexpr BasicAxisRotation fromCosSin(const T cos, const T sin) {
+    BasicAxisRotation result;
+    result.cos_ = cos;
+    result.sin_ = sin;
+    return result;
+  }
+
+  constexpr T cos() const { return cos_; }
+  constexpr T sin() const { return sin_; }
+  // Angle in [-pi, pi].
+  T angle() const { return std::atan2(sin_, cos_); }
+
+  constexpr BasicVector3<T> rotate(const BasicVector3<T> &point) const {
+    constexpr int kI{detail::firstRotatedIndex(A)};
+    constexpr int kJ{detail::secondRotatedIndex(A)};
+    BasicVector3<T> result{point};
+    result.atUnchecked(kI) =
+        cos_ * point.atUnchecked(kI) - sin_ * point.atUnchecked(kJ);
+    result.atUnchecked(kJ) =
+        sin_ * point.atUnchecked(kI) + cos_ * point.atUnchecked(kJ);
+    return result;
+  }
+  constexpr BasicMatrix3<T> rotation() const {
+    return detail::rotateRows<A>(cos_, sin_, BasicMatrix3<T>::kIdentity);
+  }
+  constexpr BasicAxisRotation inverse() const {
+    return fromCosSin(cos_, -sin_);
+  }
+
+  constexpr BasicIsometry<T> toIsometry() const {
+    return BasicIsometry<T>{BasicVector3<T>::kZero, rotation()};
+  }
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  constexpr operator BasicIsometry<T>() const { return toIsometry(); }
+
+  constexpr BasicAxisRotation &operator*=(const BasicAxisRotation &rhs) {
+    return *this = *this * rhs;
+  }
+
+  // Within one epsilon, like vectors and matrices.
+  constexpr bool operator==(const BasicAxisRotation &rhs) const {
+    return detail::almostEqual(cos_, rhs.cos_) &&
+           detail::almostEqual(sin_, rhs.sin_);
+  }
+  constexpr bool operator!=(const BasicAxisRotation &rhs) const {
+    return !(*this == rhs);
+  }
+
+  friend constexpr BasicAxisRotation operator*(const BasicAxisRotation &lhs,
+                                               const BasicAxisRotation &rhs) {
+    return fromCosSin(lhs.cos_ * rhs.cos_ - lhs.sin_ * rhs.sin_,
+                      lhs.sin_ * rhs.cos_ + lhs.cos_ * rhs.sin_);
+  }
+  friend constexpr BasicVector3<T> operator*(const BasicAxisRotation &lhs,
+                                             const BasicVector3<T> &rhs) {
+    return lhs.rotate(rhs);
+  }
+
+ private:
+  T cos_{1};
+  T sin_{0};
+};
+
+// Rotation around the z axis followed by a translation, e.g. the pose of a
+// ground vehicle. The translation may have a z component, which commutes
+// with the rotation, so these are closed under composition.
+template <typename T>
+class BasicPlanarIsometry {
+ public:
+  typedef T Scalar;
+
+  constexpr BasicPlanarIsometry() = default;
+  constexpr BasicPlanarIsometry(
+      const BasicVector3<T> &translation,
+      const BasicAxisRotation<Axis::kZ, T> &rotation)
+      : translation_{translation}, rotation_{rotation} {}
+  // Pose at (|x|, |y|) in the xy plane, heading |heading| radians from x.
+  BasicPlanarIsometry(const T x, const T y, const T heading)
+      : translation_{x, y, T{0}}, rotation_{heading} {}
+
+  constexpr const BasicVector3<T> &translation() const {
+    return translation_;
+  }
+  constexpr const BasicAxisRotation<Axis::kZ, T> &rotation() const {
+    return rotation_;
+  }
+
+  constexpr BasicVector3<T> transform(const BasicVector3<T> &point) const {
+    return rotation_.rotate(point) + translation_;
+  }
+  constexpr BasicPlanarIsometry inverse() const {
+    const BasicAxisRotation<Axis::kZ, T> inverse_rotation{
+        rotation_.inverse()};
+    return BasicPlanarIsometry{
+        T{-1} * inverse_rotation.rotate(translation_), inverse_rotation};
+  }
+
+  constexpr BasicIsometry<T> toIsometry() const {
+    return BasicIsometry<T>{translation_, rotation_.rotation()};
+  }
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  constexpr operator BasicIsometry<T>() const { return toIsometry(); }
+
+  constexpr BasicPlanarIsometry &operator*=(const BasicPlanarIsometry &rhs) {
+    return *this = *this * rhs;
+  }
+
+  constexpr bool operator==(const BasicPlanarIsometry &rhs) const {
+    return (translation_ == rhs.translation_) && (rotation_ == rhs.rotation_);
+  }
+  constexpr bool operator!=(const BasicPlanarIsometry &rhs) const {
+    return !(*this == rhs);
+  }
+
+  friend constexpr BasicPlanarIsometry operator*(
+      const BasicPlanarIsometry &lhs, const BasicPlanarIsometry &rhs) {
+    return BasicPlanarIsometry{lhs.transform(rhs.translation_),
+                               lhs.rotation_ * rhs.rotation_};
+  }
+  friend constexpr BasicVector3<T> operator*(const BasicPlanarIsometry &lhs,
+                                             const BasicVector3<T> &rhs) {
+    return lhs.transform(rhs);
+  }
+
+ private:
+  BasicVector3<T> translation_;
+  BasicAxisRotation<Axis::kZ, T> rotation_;
+};
+
+// Compositions with full isometries.
+
+template <typename T>
+constexpr BasicIsometry<T> operator*(const BasicTranslation3<T> &lhs,
+                                     const BasicIsometry<T> &rhs) {
+  return BasicIsometry<T>{lhs.translation() + rhs.translation(),
+                          rhs.rotation()};
+}
+template <typename T>
+constexpr BasicIsometry<T> operator*(const BasicIsometry<T> &lhs,
+                                     const BasicTranslation3<T> &rhs) {
+  return BasicIsometry<T>{lhs.transform(rhs.translation()), lhs.rotation()};
+}
+
+template <Axis A, typename T>
+constexpr BasicIsometry<T> operator*(const BasicAxisRotation<A, T> &lhs,
+                                     const BasicIsometry<T> &rhs) {
+  return BasicIsometry<T>{
+      lhs.rotate(rhs.translation()),
+      detail::rotateRows<A>(lhs.cos(), lhs.sin(), rhs.rotation())};
+}
+template <Axis A, typename T>
+constexpr BasicIsometry<T> operator*(const BasicIsometry<T> &lhs,
+                                     const BasicAxisRotation<A, T> &rhs) {
+  return BasicIsometry<T>{
+      lhs.translation(),
+      detail::rotateColumns<A>(lhs.rotation(), rhs.cos(), rhs.sin())};
+}
+
+template <typename T>
+constexpr BasicIsometry<T> operator*(const BasicPlanarIsometry<T> &lhs,
+                                     const BasicIsometry<T> &rhs) {
+  return BasicIsometry<T>{
+      lhs.transform(rhs.translation()),
+      detail::rotateRows<Axis::kZ>(lhs.rotation().cos(), lhs.rotation().sin(),
+                                   rhs.rotation())};
+}
+template <typename T>
+constexpr BasicIsometry<T> operator*(const BasicIsometry<T> &lhs,
+                                     const BasicPlanarIsometry<T> &rhs) {
+  return BasicIsometry<T>{
+      lhs.transform(rhs.translation()),
+      detail::rotateColumns<Axis::kZ>(lhs.rotation(), rhs.rotation().cos(),
+                                      rhs.rotation().sin())};
+}
+
+// Compositions between the lightweight types. Translations and rotations
+// around z give planar isometries; rotations around x and y leave the plane
+// and give full isometries.
+
+template <typename T>
+constexpr BasicPlanarIsometry<T> operator*(
+    const BasicTranslation3<T> &lhs,
+    const BasicAxisRotation<Axis::kZ, T> &rhs) {
+  return BasicPlanarIsometry<T>{lhs.translation(), rhs};
+}
+template <typename T>
+constexpr BasicPlanarIsometry<T> operator*(
+    const BasicAxisRotation<Axis::kZ, T> &lhs,
+    const BasicTranslation3<T> &rhs) {
+  return BasicPlanarIsometry<T>{lhs.rotate(rhs.translation()), lhs};
+}
+
+template <Axis A, typename T>
+  requires(A != Axis::kZ)
+constexpr BasicIsometry<T> operator*(const BasicTranslation3<T> &lhs,
+                                     const BasicAxisRotation<A, T> &rhs) {
+  return BasicIsometry<T>{lhs.translation(), rhs.rotation()};
+}
+template <Axis A, typename T>
+  requires(A != Axis::kZ)
+constexpr BasicIsometry<T> operator*(const BasicAxisRotation<A, T> &lhs,
+                                     const BasicTranslation3<T> &rhs) {
+  return BasicIsometry<T>{lhs.rotate(rhs.translation()), lhs.rotation()};
+}
+
+template <Axis A, Axis B, typename T>
+  requires(A != B)
+constexpr BasicIsometry<T> operator*(const BasicAxisRotation<A, T> &lhs,
+                                     const BasicAxisRotation<B, T> &rhs) {
+  return BasicIsometry<T>{
+      BasicVector3<T>::kZero,
+      detail::rotateRows<A>(lhs.cos(), lhs.sin(), rhs.rotation())};
+}
+
+template <typename T>
+constexpr BasicPlanarIsometry<T> operator*(const BasicTranslation3<T> &lhs,
+                                           const BasicPlanarIsometry<T> &rhs) {
+  return BasicPlanarIsometry<T>{lhs.translation() + rhs.translation(),
+                                rhs.rotation()};
+}
+template <typename T>
+constexpr BasicPlanarIsometry<T> operator*(const BasicPlanarIsometry<T> &lhs,
+                                           const BasicTranslation3<T> &rhs) {
+  return BasicPlanarIsometry<T>{lhs.transform(rhs.translation()),
+                                lhs.rotation()};
+}
+
+template <typename T>
+constexpr BasicPlanarIsometry<T> operator*(
+    const BasicAxisRotation<Axis::kZ, T> &lhs,
+    const BasicPlanarIsometry<T> &rhs) {
+  return BasicPlanarIsometry<T>{lhs.rotate(rhs.translation()),
+                                lhs * rhs.rotation()};
+}
+template <typename T>
+constexpr BasicPlanarIsometry<T> operator*(
+    const BasicPlanarIsometry<T> &lhs,
+    const BasicAxisRotation<Axis::kZ, T> &rhs) {
+  return BasicPlanarIsometry<T>{lhs.translation(), lhs.rotation() * rhs};
+}
+
+template <Axis A, typename T>
+  requires(A != Axis::kZ)
+constexpr BasicIsometry<T> operator*(const BasicAxisRotation<A, T> &lhs,
+                                     const BasicPlanarIsometry<T> &rhs) {
+  return lhs * rhs.toIsometry();
+}
+template <Axis A, typename T>
+  requires(A != Axis::kZ)
+constexpr BasicIsometry<T> operator*(const BasicPlanarIsometry<T> &lhs,
+                                     const BasicAxisRotation<A, T> &rhs) {
+  return lhs.toIsometry() * rhs;
+}
+
+using Translation3 = BasicTranslation3<double>;
+using Translation3f = BasicTranslation3<float>;
+using Translation3l = BasicTranslation3<long double>;
+template <Axis A>
+using AxisRotation = BasicAxisRotation<A, double>;
+template <Axis A>
+using AxisRotationf = BasicAxisRotation<A, float>;
+template <Axis A>
+using AxisRotationl = BasicAxisRotation<A, long double>;
+using PlanarIsometry = BasicPlanarIsometry<double>;
+using PlanarIsometryf = BasicPlanarIsometry<float>;
+using PlanarIsometryl = BasicPlanarIsometry<long double>;
+
+}  // namespace math
+
+}  // namespace ekumen
@@ -0,0 +1,43 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <span>
+
+#include <isometry/isometry.hpp>
+#include <isometry/thread_pool.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// In-place batch operations over large arrays, split across the threads of
+// |pool|. Short arrays, see ThreadPool::Options::serial_threshold, are
+// processed on the calling thread. Results are the same as those of the
+// equivalent element by element loop.
+
+// isometries[i] = lhs * isometries[i]. |lhs| may be an element of
+// |isometries|: it is copied before any element is updated.
+void composeBatch(const Isometry &lhs, std::span<Isometry> isometries,
+                  ThreadPool &pool = ThreadPool::global());
+
+// isometries[i] = isometries[i] * rhs, with |rhs| copied the same way.
+void composeBatch(std::span<Isometry> isometries, const Isometry &rhs,
+                  ThreadPool &pool = ThreadPool::global());
+
+// isometries[i] = isometries[i].inverse(). Throws std::domain_error if any
+// rotation is singular, in which case the array is left partially updated.
+void inverseBatch(std::span<Isometry> isometries,
+                  ThreadPool &pool = ThreadPool::global());
+
+// points[i] = isometry * points[i].
+void transformBatch(const Isometry &isometry, std::span<Vector3> points,
+                    ThreadPool &pool = ThreadPool::global());
+
+}  // namespace math
+
+}  // namespace ekumen
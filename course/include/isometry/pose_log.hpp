@@ -0,0 +1,118 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Pose log files hold a sequence of Vector3 or Isometry records. They are
+// laid out exactly like a full precision serialization array (see
+// serialization.hpp): a 16 byte header followed by the records as
+// little-endian doubles, which is also their in-memory layout on the
+// little-endian hosts we support.
+//
+// PoseLogReader memory-maps a log and exposes its records in place, so logs
+// much larger than the available memory can be replayed, and records are
+// used straight from the page cache without being copied or decoded.
+//
+// OS errors throw std::system_error, and malformed logs
+// std::invalid_argument. Opening a log on a big-endian host throws
+// std::runtime_error.
+template <typename T>
+class PoseLogReader {
+ public:
+  explicit PoseLogReader(const std::string &path);
+  ~PoseLogReader();
+
+  PoseLogReader(PoseLogReader &&other) noexcept;
+  PoseLogReader &operator=(PoseLogReader &&other) noexcept;
+  PoseLogReader(const PoseLogReader &) = delete;
+  PoseLogReader &operator=(const PoseLogReader &) = delete;
+
+  // Valid while the reader lives.
+  std::span<const T> records() const { return records_; }
+
+  const T &operator[](const std::size_t index) const {
+    return records_[index];
+  }
+  std::size_t size() const { return records_.size(); }
+  bool empty() const { return records_.empty(); }
+
+ private:
+  void unmap();
+
+  void *mapping_{nullptr};
+  std::size_t mapping_size_{0};
+  std::span<const T> records_;
+};
+
+// Appends records to a new pose log, truncating any existing file. Records
+// are buffered and written in blocks of |buffer_size| records. The header
+// is only updated by flush(), close() and the destructor, so readers only see
+// records up to the last of those.
+//
+// If writing records fails, the file is truncated back to the last whole
+// record before the error is thrown. Buffered records stay buffered, so
+// flush() can be retried, e.g. once disk space has been freed; a block of
+// records larger than the buffer is not appended at all. If the file can't
+// be truncated either, the writer is closed.
+template <typename T>
+class PoseLogWriter {
+ public:
+  explicit PoseLogWriter(const std::string &path,
+                         const std::size_t buffer_size = 4096);
+  // Closes the log, ignoring errors. Call close() to get them reported.
+  ~PoseLogWriter();
+
+  PoseLogWriter(const PoseLogWriter &) = delete;
+  PoseLogWriter &operator=(const PoseLogWriter &) = delete;
+
+  void append(const T &record);
+  void append(std::span<const T> records);
+
+  // Writes the buffered records and updates the header.
+  void flush();
+  // Flushes and closes the file. Further appends throw std::logic_error.
+  void close();
+
+  // Records appended so far, flushed or not.
+  std::size_t size() const { return written_ + buffer_.size(); }
+
+ private:
+  void writeBuffer();
+  // Writes |count| records after the last whole one.
+  void writeRecords(const T *records, const std::size_t count);
+
+  int fd_{-1};
+  std::string path_;
+  std::vector<T> buffer_;
+  std::size_t buffer_size_;
+  std::uint64_t written_{0};
+};
+
+using Vector3LogReader = PoseLogReader<Vector3>;
+using IsometryLogReader = PoseLogReader<Isometry>;
+using Vector3LogWriter = PoseLogWriter<Vector3>;
+using IsometryLogWriter = PoseLogWriter<Isometry>;
+
+extern template class PoseLogReader<Vector3>;
+extern template class PoseLogReader<Isometry>;
+extern template class PoseLogWriter<Vector3>;
+extern template class PoseLogWriter<Isometry>;
+
+}  // namespace math
+
+}  // namespace ekumen
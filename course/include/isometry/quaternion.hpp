@@ -0,0 +1,193 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <iostream>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Rotation quaternion w + xi + yj + zk. Rotations are only represented by
+// unit quaternions; normalize() brings a quaternion back to unit norm after
+// rounding errors have accumulated over long chains of products.
+class Quaternion {
+ public:
+  static const Quaternion kIdentity;
+
+  constexpr Quaternion() : Quaternion(1., 0., 0., 0.) {}
+  constexpr Quaternion(const double w, const double x, const double y,
+                       const double z)
+      : w_{w}, x_{x}, y_{y}, z_{z} {}
+
+  // Rotation of |angle| radians around |axis|. Throws std::invalid_argument
+  // if |axis| is a null vector.
+  static Quaternion fromAxisAngle(const Vector3 &axis, const double angle);
+  // Rotation represented by the rotation matrix |rotation|.
+  static Quaternion fromRotationMatrix(const Matrix3 &rotation);
+
+  constexpr double w() const { return w_; }
+  constexpr double x() const { return x_; }
+  constexpr double y() const { return y_; }
+  constexpr double z() const { return z_; }
+
+  // Hamilton product, 16 multiplies.
+  constexpr Quaternion operator*(const Quaternion &rhs) const {
+    return Quaternion{w_ * rhs.w_ - x_ * rhs.x_ - y_ * rhs.y_ - z_ * rhs.z_,
+                      w_ * rhs.x_ + x_ * rhs.w_ + y_ * rhs.z_ - z_ * rhs.y_,
+                      w_ * rhs.y_ - x_ * rhs.z_ + y_ * rhs.w_ + z_ * rhs.x_,
+                      w_ * rhs.z_ + x_ * rhs.y_ - y_ * rhs.x_ + z_ * rhs.w_};
+  }
+  constexpr Quaternion &operator*=(const Quaternion &rhs) {
+    return *this = *this * rhs;
+  }
+  constexpr Quaternion operator-() const {
+    return Quaternion{-w_, -x_, -y_, -z_};
+  }
+
+  // The conjugate is the inverse rotation of a unit quaternion.
+  constexpr Quaternion conjugate() const {
+    return Quaternion{w_, -x_, -y_, -z_};
+  }
+  constexpr double dot(const Quaternion &rhs) const {
+    return w_ * rhs.w_ + x_ * rhs.x_ + y_ * rhs.y_ + z_ * rhs.z_;
+  }
+  double norm() const;
+  // Scales the quaternion to unit norm. Throws std::domain_error on a null
+  // quaternion.
+  Quaternion &normalize();
+  Quaternion normalized() const;
+
+  // Rotates |point|, assuming a unit quaternion. Uses the
+  // p + 2w (u x p) + 2u x (u x p) form, 15 multiplies.
+  constexpr Vector3 rotate(const Vector3 &point) const {
+    const Vector3 u{x_, y_, z_};
+    const Vector3 t{2. * u.cross(point)};
+    return point + w_ * t + u.cross(t);
+  }
+  // Rotation matrix of the rotation, assuming a unit quaternion.
+  constexpr Matrix3 toRotationMatrix() const {
+    const double xx{x_ * x_}, yy{y_ * y_}, zz{z_ * z_};
+    const double xy{x_ * y_}, xz{x_ * z_}, yz{y_ * z_};
+    const double wx{w_ * x_}, wy{w_ * y_}, wz{w_ * z_};
+    return Matrix3{
+        Vector3{1. - 2. * (yy + zz), 2. * (xy - wz), 2. * (xz + wy)},
+        Vector3{2. * (xy + wz), 1. - 2. * (xx + zz), 2. * (yz - wx)},
+        Vector3{2. * (xz - wy), 2. * (yz + wx), 1. - 2. * (xx + yy)}};
+  }
+
+  // Component-wise comparison. Note q and -q represent the same rotation but
+  // do not compare equal.
+  constexpr bool operator==(const Quaternion &rhs) const {
+    return detail::almostEqual(w_, rhs.w_) &&
+           detail::almostEqual(x_, rhs.x_) &&
+           detail::almostEqual(y_, rhs.y_) && detail::almostEqual(z_, rhs.z_);
+  }
+  constexpr bool operator!=(const Quaternion &rhs) const {
+    return !(*this == rhs);
+  }
+
+ private:
+  double w_;
+  double x_;
+  double y_;
+  double z_;
+};
+
+inline constexpr Quaternion Quaternion::kIdentity{1., 0., 0., 0.};
+
+// Spherical linear interpolation between the unit quaternions |from|
+// (|t| = 0) and |to| (|t| = 1), along the shortest arc.
+Quaternion slerp(const Quaternion &from, const Quaternion &to, const double t);
+
+std::ostream &operator<<(std::ostream &os, const Quaternion &q);
+
+// Isometry that keeps its rotation as a unit quaternion. Compared to
+// Isometry it is 7 doubles instead of 12, composes rotations with 16
+// multiplies instead of 27 and renormalizes with a single square root.
+// The rotation matrix is only built when rotation() is called.
+class QuaternionIsometry {
+ public:
+  constexpr QuaternionIsometry() = default;
+  constexpr QuaternionIsometry(const Vector3 &translation,
+                               const Quaternion &rotation)
+      : translation_{translation}, rotation_{rotation} {}
+  // Converts an Isometry, whose rotation must be a rotation matrix.
+  explicit QuaternionIsometry(const Isometry &isometry)
+      : translation_{isometry.translation()},
+        rotation_{Quaternion::fromRotationMatrix(isometry.rotation())} {}
+
+  static constexpr QuaternionIsometry fromTranslation(
+      const Vector3 &translation) {
+    return QuaternionIsometry{translation, Quaternion::kIdentity};
+  }
+  static QuaternionIsometry rotateAround(const Vector3 &axis,
+                                         const double angle);
+  static QuaternionIsometry fromEulerAngles(const double roll,
+                                            const double pitch,
+                                            const double yaw);
+
+  constexpr const Vector3 &translation() const { return translation_; }
+  constexpr const Quaternion &quaternion() const { return rotation_; }
+  constexpr Matrix3 rotation() const { return rotation_.toRotationMatrix(); }
+  constexpr Isometry toIsometry() const {
+    return Isometry{translation_, rotation()};
+  }
+
+  constexpr Vector3 transform(const Vector3 &point) const {
+    return rotation_.rotate(point) + translation_;
+  }
+
+  constexpr QuaternionIsometry compose(const QuaternionIsometry &rhs) const {
+    return QuaternionIsometry{
+        rotation_.rotate(rhs.translation_) + translation_,
+        rotation_ * rhs.rotation_};
+  }
+  constexpr QuaternionIsometry inverse() const {
+    const Quaternion inverse_rotation{rotation_.conjugate()};
+    return QuaternionIsometry{-1. * inverse_rotation.rotate(translation_),
+                              inverse_rotation};
+  }
+
+  // Brings the rotation back to unit norm.
+  QuaternionIsometry &normalize();
+
+  constexpr QuaternionIsometry &operator*=(const QuaternionIsometry &rhs) {
+    return *this = compose(rhs);
+  }
+
+  // q and -q are the same rotation, so both compare equal.
+  constexpr bool operator==(const QuaternionIsometry &rhs) const {
+    return (translation_ == rhs.translation_) &&
+           ((rotation_ == rhs.rotation_) || (rotation_ == -rhs.rotation_));
+  }
+  constexpr bool operator!=(const QuaternionIsometry &rhs) const {
+    return !(*this == rhs);
+  }
+
+ private:
+  Vector3 translation_;
+  Quaternion rotation_;
+};
+
+constexpr QuaternionIsometry operator*(const QuaternionIsometry &lhs,
+                                       const QuaternionIsometry &rhs) {
+  return lhs.compose(rhs);
+}
+
+constexpr Vector3 operator*(const QuaternionIsometry &lhs,
+                            const Vector3 &rhs) {
+  return lhs.transform(rhs);
+}
+
+std::ostream &operator<<(std::ostream &os, const QuaternionIsometry &t);
+
+}  // namespace math
+
+}  // namespace ekumen
@@ -0,0 +1,98 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+namespace serialization {
+
+// Binary encoding of vectors, matrices and isometries.
+//
+// Values are encoded as their doubles in IEEE-754 binary64 little-endian
+// format: Vector3 as (x, y, z), Matrix3 row by row and Isometry as its
+// translation followed by its rotation. The compact isometry encoding
+// replaces the rotation matrix by its unit quaternion (w, x, y, z), 56
+// instead of 96 bytes, at the cost of renormalizing the rotation on decode.
+//
+// Arrays are prefixed with a header:
+//
+//   bytes  0-3   magic "ISOB"
+//   byte   4     format version
+//   byte   5     record type, see RecordType
+//   bytes  6-7   reserved, zero
+//   bytes  8-15  number of records, unsigned little-endian
+//
+// On little-endian hosts bulk encoding and decoding of full precision records
+// are plain memory copies.
+
+enum class RecordType : std::uint8_t {
+  kVector3 = 1,
+  kMatrix3 = 2,
+  kIsometry = 3,
+  kCompactIsometry = 4,
+};
+
+constexpr std::uint8_t kFormatVersion{1};
+
+constexpr std::size_t kHeaderSize{16};
+constexpr std::size_t kVector3Size{3 * sizeof(double)};
+constexpr std::size_t kMatrix3Size{9 * sizeof(double)};
+constexpr std::size_t kIsometrySize{12 * sizeof(double)};
+constexpr std::size_t kCompactIsometrySize{7 * sizeof(double)};
+
+// Single values. Encoders write exactly k<Type>Size bytes to |out| and return
+// the number of bytes written, decoders read as many from |in|.
+std::size_t encode(const Vector3 &value, std::uint8_t *out);
+std::size_t encode(const Matrix3 &value, std::uint8_t *out);
+std::size_t encode(const Isometry &value, std::uint8_t *out);
+// The rotation of |value| must be a rotation matrix.
+std::size_t encodeCompact(const Isometry &value, std::uint8_t *out);
+
+Vector3 decodeVector3(const std::uint8_t *in);
+Matrix3 decodeMatrix3(const std::uint8_t *in);
+Isometry decodeIsometry(const std::uint8_t *in);
+// Throws std::invalid_argument if the quaternion is null or not finite.
+Isometry decodeCompactIsometry(const std::uint8_t *in);
+
+// Arrays. Encoders append a header and the records to |out|. Decoders throw
+// std::invalid_argument if |in| is not exactly one array of the requested
+// record type, or was written by a newer format version.
+void encode(std::span<const Vector3> values, std::vector<std::uint8_t> &out);
+void encode(std::span<const Matrix3> values, std::vector<std::uint8_t> &out);
+void encode(std::span<const Isometry> values, std::vector<std::uint8_t> &out);
+void encodeCompact(std::span<const Isometry> values,
+                   std::vector<std::uint8_t> &out);
+
+std::vector<Vector3> decodeVector3s(std::span<const std::uint8_t> in);
+std::vector<Matrix3> decodeMatrix3s(std::span<const std::uint8_t> in);
+std::vector<Isometry> decodeIsometries(std::span<const std::uint8_t> in);
+std::vector<Isometry> decodeCompactIsometries(
+    std::span<const std::uint8_t> in);
+
+// Array headers on their own, for containers that store the records
+// elsewhere, e.g. files. encodeHeader writes kHeaderSize bytes to |out|.
+// decodeHeader returns the record count of the header at the start of |in|,
+// and throws std::invalid_argument if it is not a valid header of |type|.
+void encodeHeader(const RecordType type, const std::uint64_t count,
+                  std::uint8_t *out);
+std::uint64_t decodeHeader(std::span<const std::uint8_t> in,
+                           const RecordType type);
+
+}  // namespace serialization
+
+}  // namespace math
+
+}  // namespace ekumen
@@ -0,0 +1,58 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Text formatting and parsing in the operator<< formats:
+//
+//   Vector3   (x: 1, y: 2, z: 3)
+//   Matrix3   [[1, 2, 3], [4, 5, 6], [7, 8, 9]]
+//   Isometry  [T: (x: 1, y: 2, z: 3), R:[[1, 0, 0], [0, 1, 0], [0, 0, 1]]]
+//
+// Unlike operator<<, these never allocate and don't depend on the stream
+// locale or precision. Numbers are written with the shortest representation
+// that parses back to the same double, so fromChars(toChars(v)) == v.
+//
+// Both follow the std::to_chars and std::from_chars conventions. toChars
+// writes into [first, last) and returns the end of the text, or
+// std::errc::value_too_large and |last| if it doesn't fit; no more than
+// k<Type>MaxChars characters are ever needed. fromChars reads from
+// [first, last), skipping whitespace around numbers and separators, and
+// returns the end of the parsed text. On error it leaves |value| untouched
+// and returns |first| with std::errc::invalid_argument, or the end of the
+// offending number with std::errc::result_out_of_range.
+
+// Longest shortest round-trip representation of a double, e.g.
+// "-2.2250738585072014e-308".
+constexpr std::size_t kDoubleMaxChars{24};
+constexpr std::size_t kVector3MaxChars{3 * kDoubleMaxChars + 15};
+constexpr std::size_t kMatrix3MaxChars{9 * kDoubleMaxChars + 24};
+constexpr std::size_t kIsometryMaxChars{kVector3MaxChars + kMatrix3MaxChars +
+                                        9};
+
+std::to_chars_result toChars(char *first, char *last, const Vector3 &value);
+std::to_chars_result toChars(char *first, char *last, const Matrix3 &value);
+std::to_chars_result toChars(char *first, char *last, const Isometry &value);
+
+std::from_chars_result fromChars(const char *first, const char *last,
+                                 Vector3 &value);
+std::from_chars_result fromChars(const char *first, const char *last,
+                                 Matrix3 &value);
+std::from_chars_result fromChars(const char *first, const char *last,
+                                 Isometry &value);
+
+}  // namespace math
+
+}  // namespace ekumen
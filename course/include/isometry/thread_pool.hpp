@@ -0,0 +1,117 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ekumen {
+
+namespace math {
+
+// Fixed set of threads that run data-parallel loops, see parallelFor().
+//
+// A loop over [0, count) is cut into chunks of Options::chunk_size indices,
+// and the chunks are dealt out evenly to the participating threads: the
+// workers and the calling thread. Each thread takes chunks from the front of
+// its own share, and once that is exhausted steals chunks from the back of
+// the others', so uneven chunk costs don't leave threads idle.
+//
+// Loops shorter than Options::serial_threshold, and loops started from within
+// another loop, run on the calling thread. Concurrent parallelFor() calls
+// from different threads are run one after the other.
+class ThreadPool {
+ public:
+  struct Options {
+    // Indices per unit of work. Larger chunks mean less scheduling overhead,
+    // smaller ones better load balancing.
+    std::size_t chunk_size{1024};
+    // Loops with fewer indices run on the calling thread.
+    std::size_t serial_threshold{8192};
+  };
+
+  // Runs loops on |threads| threads, the caller included. Throws
+  // std::invalid_argument if |threads| or the chunk size are zero.
+  explicit ThreadPool(const std::size_t threads);
+  ThreadPool(const std::size_t threads, const Options &options);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Pool shared by default by the batch operations, with one thread per
+  // hardware thread.
+  static ThreadPool &global();
+
+  // Threads running each loop, the caller included.
+  std::size_t size() const { return workers_.size() + 1; }
+  const Options &options() const { return options_; }
+
+  // Calls |body(begin, end)| for consecutive ranges covering [0, count), and
+  // returns once all of them are done. Ranges may run concurrently. If any
+  // call throws, the remaining ranges still run and the first exception is
+  // rethrown.
+  template <typename Body>
+  void parallelFor(const std::size_t count, Body &&body) {
+    using BodyType = std::remove_reference_t<Body>;
+    run(count,
+        [](void *context, const std::size_t begin, const std::size_t end) {
+          (*static_cast<BodyType *>(context))(begin, end);
+        },
+        const_cast<void *>(static_cast<const void *>(&body)));
+  }
+
+ private:
+  using Task = void (*)(void *context, std::size_t begin, std::size_t end);
+
+  // Share of the chunks of the current loop assigned to one thread, packed
+  // as the (begin, end) chunk indices in the high and low halves.
+  struct alignas(64) Share {
+    std::atomic<std::uint64_t> chunks{0};
+  };
+
+  void run(const std::size_t count, Task task, void *context);
+  void workerLoop(const std::size_t index);
+  // Runs chunks of the current loop until none is left, starting with the
+  // share of thread |index|.
+  void work(const std::size_t index);
+  void runChunk(const std::uint64_t chunk);
+
+  const Options options_;
+  std::vector<std::thread> workers_;
+  std::unique_ptr<Share[]> shares_;
+
+  // Current loop.
+  Task task_{nullptr};
+  void *context_{nullptr};
+  std::size_t count_{0};
+  std::size_t chunk_size_{0};
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+
+  // Serializes loops started by different threads.
+  std::mutex run_mutex_;
+  // Guards the fields below, which hand loops to the workers.
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  std::uint64_t generation_{0};
+  std::size_t running_{0};
+  bool stop_{false};
+};
+
+}  // namespace math
+
+}  // namespace ekumen
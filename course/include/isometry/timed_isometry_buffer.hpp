@@ -0,0 +1,75 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include <isometry/isometry.hpp>
+#include <isometry/quaternion.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Bounded history of time-stamped isometries, e.g. the transform between two
+// frames as reported by a sensor. Once full, inserting drops the oldest
+// entry. Storage is allocated up front, so inserts and lookups never
+// allocate.
+//
+// Lookups find the neighbouring entries with a binary search and interpolate
+// between them: linearly on the translation and with slerp on the rotation.
+// Entries are kept as QuaternionIsometry values, so rotations are only
+// converted to quaternions once, on insertion.
+class TimedIsometryBuffer {
+ public:
+  // Storage comes from |resource|. Throws std::invalid_argument if
+  // |capacity| is zero.
+  explicit TimedIsometryBuffer(
+      const std::size_t capacity,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  // Appends |isometry| at |time|. Timestamps must not decrease, an isometry
+  // at the newest timestamp replaces it. Throws std::invalid_argument on
+  // out of order or non-finite timestamps. The rotation must be a rotation
+  // matrix.
+  void insert(const double time, const Isometry &isometry);
+  void insert(const double time, const QuaternionIsometry &isometry);
+
+  // Isometry at |time|, interpolated between the closest entries. Throws
+  // std::out_of_range if |time| is outside [oldestTime(), newestTime()].
+  Isometry lookup(const double time) const;
+  QuaternionIsometry lookupQuaternion(const double time) const;
+
+  // Both throw std::out_of_range on an empty buffer.
+  double oldestTime() const;
+  double newestTime() const;
+
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return entries_.size(); }
+  bool empty() const { return size_ == 0; }
+  void clear();
+
+ private:
+  struct Entry {
+    double time;
+    QuaternionIsometry isometry;
+  };
+
+  // Entry at position |index| counting from the oldest one.
+  const Entry &at(const std::size_t index) const;
+
+  std::pmr::vector<Entry> entries_;
+  // Position in |entries_| of the oldest entry.
+  std::size_t first_{0};
+  std::size_t size_{0};
+};
+
+}  // namespace math
+
+}  // namespace ekumen
@@ -0,0 +1,87 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include <isometry/isometry.hpp>
+
+namespace ekumen {
+
+namespace math {
+
+// Product of isometries, t1 * t2 * ... * tn, evaluated lazily when points are
+// pushed through it.
+//
+// Composing the chain costs about 63 flops per isometry, after which each
+// point costs 18, while applying each isometry in turn, right to left, costs
+// 18 flops per isometry and point. Composing first pays off from around four
+// points regardless of the chain length, so transforms of fewer points than
+// kBreakEvenPoints apply the isometries one by one and larger ones compose
+// them first.
+//
+// Like the arithmetic expressions, chains refer to their operands, which
+// must outlive them. Temporary operands would dangle, so building chains from
+// them doesn't compile.
+class TransformChain {
+ public:
+  static constexpr std::size_t kMaxLength{16};
+  static constexpr std::size_t kBreakEvenPoints{4};
+
+  // The empty chain is the identity.
+  TransformChain() = default;
+  explicit TransformChain(const Isometry &isometry) { *this *= isometry; }
+  explicit TransformChain(const Isometry &&isometry) = delete;
+
+  // Appends |isometry| to the right of the chain, so that it is the first to
+  // be applied to points. Throws std::length_error past kMaxLength operands.
+  TransformChain &operator*=(const Isometry &isometry) {
+    if (size_ == kMaxLength) {
+      throwLengthError();
+    }
+    operands_[size_++] = &isometry;
+    return *this;
+  }
+  TransformChain &operator*=(const Isometry &&isometry) = delete;
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // The chain as a single isometry.
+  Isometry compose() const;
+
+  Vector3 transform(const Vector3 &point) const;
+  // Transforms every point in |input| into |output|. Throws
+  // std::invalid_argument if their sizes differ.
+  void transform(std::span<const Vector3> input,
+                 std::span<Vector3> output) const;
+  // Transforms every point in |points| in place.
+  void transform(std::span<Vector3> points) const;
+
+ private:
+  [[noreturn]] static void throwLengthError();
+
+  // Only the first |size_| operands are ever read, so the rest are left
+  // uninitialized to keep building chains cheap.
+  std::array<const Isometry *, kMaxLength> operands_;
+  std::size_t size_{0};
+};
+
+inline TransformChain operator*(TransformChain lhs, const Isometry &rhs) {
+  return lhs *= rhs;
+}
+TransformChain operator*(TransformChain lhs, const Isometry &&rhs) = delete;
+
+inline Vector3 operator*(const TransformChain &lhs, const Vector3 &rhs) {
+  return lhs.transform(rhs);
+}
+
+}  // namespace math
+
+}  // namespace ekumen
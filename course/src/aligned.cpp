@@ -0,0 +1,38 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/aligned.hpp>
+
+#include <isometry/kernels.hpp>
+
+namespace ekumen {
+namespace math {
+
+AlignedMatrix3 AlignedMatrix3::product(const AlignedMatrix3 &rhs) const {
+  AlignedMatrix3 result{detail::Uninitialized{}};
+  kernels::activeKernels().aligned_matrix_product(data(), rhs.data(),
+                                                  result.data());
+  return result;
+}
+
+AlignedVector3 operator*(const AlignedMatrix3 &lhs,
+                         const AlignedVector3 &rhs) {
+  AlignedVector3 result{detail::Uninitialized{}};
+  kernels::activeKernels().aligned_matrix_vector_product(
+      lhs.data(), rhs.data(), result.data());
+  return result;
+}
+
+std::ostream &operator<<(std::ostream &os, const AlignedVector3 &v) {
+  return os << v.compact();
+}
+
+std::ostream &operator<<(std::ostream &os, const AlignedMatrix3 &m) {
+  return os << m.compact();
+}
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,162 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/frame_graph.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace ekumen {
+namespace math {
+
+FrameGraph::FrameGraph(std::string_view root_name,
+                       std::pmr::memory_resource *resource)
+    : frames_(resource), ids_(resource), path_(resource) {
+  const Isometry identity{Isometry::fromTranslation(Vector3::kZero)};
+  // Frames are moved into |frames_|, and moves keep the resource of their
+  // members.
+  frames_.push_back(Frame{std::pmr::string{root_name, resource}, kRootId,
+                          identity, std::pmr::vector<FrameId>{resource},
+                          identity, true});
+  ids_.emplace(root_name, kRootId);
+}
+
+FrameGraph::FrameId FrameGraph::addFrame(std::string_view name,
+                                         const FrameId parent,
+                                         const Isometry &parent_from_frame) {
+  if (contains(name)) {
+    throw std::invalid_argument("Frame name already in use: " +
+                                std::string{name});
+  }
+  frame(parent);
+  const FrameId id{frames_.size()};
+  frames_.push_back(Frame{std::pmr::string{name, resource()}, parent,
+                          parent_from_frame,
+                          std::pmr::vector<FrameId>{resource()}, Isometry{},
+                          false});
+  frames_[parent].children.push_back(id);
+  ids_.emplace(name, id);
+  return id;
+}
+
+FrameGraph::FrameId FrameGraph::addFrame(std::string_view name,
+                                         std::string_view parent,
+                                         const Isometry &parent_from_frame) {
+  return addFrame(name, id(parent), parent_from_frame);
+}
+
+void FrameGraph::setTransform(const FrameId frame_id,
+                              const Isometry &parent_from_frame) {
+  Frame &updated{frame(frame_id)};
+  if (frame_id == kRootId) {
+    throw std::invalid_argument("The root frame has no parent");
+  }
+  updated.parent_from_frame = parent_from_frame;
+  invalidate(frame_id);
+}
+
+void FrameGraph::setTransform(std::string_view frame,
+                              const Isometry &parent_from_frame) {
+  setTransform(id(frame), parent_from_frame);
+}
+
+FrameGraph::FrameId FrameGraph::id(std::string_view name) const {
+  const auto it = ids_.find(name);
+  if (it == ids_.end()) {
+    throw std::out_of_range("Unknown frame: " + std::string{name});
+  }
+  return it->second;
+}
+
+std::string_view FrameGraph::name(const FrameId frame_id) const {
+  return frame(frame_id).name;
+}
+
+FrameGraph::FrameId FrameGraph::parent(const FrameId frame_id) const {
+  return frame(frame_id).parent;
+}
+
+const Isometry &FrameGraph::parentTransform(const FrameId frame_id) const {
+  return frame(frame_id).parent_from_frame;
+}
+
+bool FrameGraph::contains(std::string_view name) const {
+  return ids_.find(name) != ids_.end();
+}
+
+const Isometry &FrameGraph::rootTransform(const FrameId frame_id) const {
+  const Frame &target{frame(frame_id)};
+  if (target.cached) {
+    return target.root_from_frame;
+  }
+  // Walks up to the closest cached ancestor, which at worst is the root, and
+  // then composes the edges back down.
+  path_.clear();
+  for (FrameId current = frame_id; !frames_[current].cached;
+       current = frames_[current].parent) {
+    path_.push_back(current);
+  }
+  while (!path_.empty()) {
+    const Frame &current{frames_[path_.back()]};
+    current.root_from_frame = frames_[current.parent].root_from_frame.compose(
+        current.parent_from_frame);
+    current.cached = true;
+    path_.pop_back();
+  }
+  return target.root_from_frame;
+}
+
+const Isometry &FrameGraph::rootTransform(std::string_view frame) const {
+  return rootTransform(id(frame));
+}
+
+Isometry FrameGraph::relativeTransform(const FrameId target,
+                                       const FrameId source) const {
+  if (target == source) {
+    return Isometry::fromTranslation(Vector3::kZero);
+  }
+  const Isometry &root_from_target{rootTransform(target)};
+  const Isometry &root_from_source{rootTransform(source)};
+  return root_from_target.inverse().compose(root_from_source);
+}
+
+Isometry FrameGraph::relativeTransform(std::string_view target,
+                                       std::string_view source) const {
+  return relativeTransform(id(target), id(source));
+}
+
+const FrameGraph::Frame &FrameGraph::frame(const FrameId frame_id) const {
+  if (frame_id >= frames_.size()) {
+    throw std::out_of_range("Unknown frame id: " + std::to_string(frame_id));
+  }
+  return frames_[frame_id];
+}
+
+FrameGraph::Frame &FrameGraph::frame(const FrameId frame_id) {
+  if (frame_id >= frames_.size()) {
+    throw std::out_of_range("Unknown frame id: " + std::to_string(frame_id));
+  }
+  return frames_[frame_id];
+}
+
+void FrameGraph::invalidate(const FrameId frame_id) {
+  // Frames whose cache is already invalid have an invalid subtree as well,
+  // so the traversal stops there.
+  path_.clear();
+  path_.push_back(frame_id);
+  while (!path_.empty()) {
+    Frame &current{frames_[path_.back()]};
+    path_.pop_back();
+    if (!current.cached) {
+      continue;
+    }
+    current.cached = false;
+    path_.insert(path_.end(), current.children.begin(), current.children.end());
+  }
+}
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,204 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/instrumentation.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+namespace ekumen {
+namespace math {
+namespace instrumentation {
+
+namespace {
+
+// Counters of a single thread. Only the owning thread writes them, so
+// increments are a relaxed load and store, and readers on other threads see
+// each counter either before or after an increment.
+struct ThreadCounters {
+  std::atomic<std::uint64_t> calls[kOperationCount]{};
+  std::atomic<std::uint64_t> histograms[kOperationCount][kHistogramBuckets]{};
+  std::atomic<std::uint64_t> latency_sums[kOperationCount]{};
+};
+
+void add(std::atomic<std::uint64_t> &counter, const std::uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+void accumulate(const ThreadCounters &counters, Snapshot &snapshot) {
+  for (int i = 0; i < kOperationCount; ++i) {
+    OperationStats &stats{snapshot.operations[i]};
+    stats.calls += counters.calls[i].load(std::memory_order_relaxed);
+    stats.latency_sum +=
+        counters.latency_sums[i].load(std::memory_order_relaxed);
+    for (int bucket = 0; bucket < kHistogramBuckets; ++bucket) {
+      const std::uint64_t count{
+          counters.histograms[i][bucket].load(std::memory_order_relaxed)};
+      stats.latency_histogram[bucket] += count;
+      stats.samples += count;
+    }
+  }
+}
+
+// Counters of the live threads, and the merged ones of the threads that have
+// exited.
+class Registry {
+ public:
+  static Registry &instance() {
+    // Never destroyed, so that threads exiting after main() can still
+    // unregister.
+    static Registry *registry{new Registry};
+    return *registry;
+  }
+
+  void add(const ThreadCounters *counters) {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    live_.push_back(counters);
+  }
+
+  void remove(const ThreadCounters *counters) {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    accumulate(*counters, retired_);
+    live_.erase(std::find(live_.begin(), live_.end(), counters));
+  }
+
+  Snapshot snapshot() const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    Snapshot result{retired_};
+    for (const ThreadCounters *counters : live_) {
+      accumulate(*counters, result);
+    }
+    return result;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<const ThreadCounters *> live_;
+  Snapshot retired_;
+};
+
+struct ThreadRegistration {
+  ThreadRegistration() { Registry::instance().add(&counters); }
+  ~ThreadRegistration() { Registry::instance().remove(&counters); }
+
+  ThreadCounters counters;
+};
+
+ThreadCounters &threadCounters() {
+  thread_local ThreadRegistration registration;
+  return registration.counters;
+}
+
+std::uint64_t now() {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+int bucketOf(const std::uint64_t nanoseconds) {
+  const int width{static_cast<int>(std::bit_width(nanoseconds))};
+  return std::clamp(width, 1, kHistogramBuckets) - 1;
+}
+
+// Inclusive, as latencies are whole nanoseconds.
+std::uint64_t bucketUpperBound(const int bucket) {
+  return (std::uint64_t{2} << bucket) - 1;
+}
+
+}  // namespace
+
+std::string_view name(const Operation operation) {
+  switch (operation) {
+    case Operation::kIsometryCompose:
+      return "isometry_compose";
+    case Operation::kIsometryInverse:
+      return "isometry_inverse";
+    case Operation::kIsometryFromEulerAngles:
+      return "isometry_from_euler_angles";
+    case Operation::kMatrix3Det:
+      return "matrix3_det";
+  }
+  return "unknown";
+}
+
+std::uint64_t OperationStats::latencyQuantile(const double quantile) const {
+  if (samples == 0) {
+    return 0;
+  }
+  const std::uint64_t rank{static_cast<std::uint64_t>(
+      std::ceil(std::clamp(quantile, 0., 1.) * static_cast<double>(samples)))};
+  std::uint64_t seen{0};
+  for (int bucket = 0; bucket < kHistogramBuckets; ++bucket) {
+    seen += latency_histogram[bucket];
+    if ((seen >= rank) && (seen > 0)) {
+      return bucketUpperBound(bucket);
+    }
+  }
+  return bucketUpperBound(kHistogramBuckets - 1);
+}
+
+Snapshot snapshot() {
+  if (!kEnabled) {
+    return Snapshot{};
+  }
+  return Registry::instance().snapshot();
+}
+
+void dump(const Snapshot &snapshot, std::ostream &os) {
+  for (int i = 0; i < kOperationCount; ++i) {
+    const std::string_view operation{name(static_cast<Operation>(i))};
+    const OperationStats &stats{snapshot.operations[i]};
+    os << "# TYPE " << operation << "_calls_total counter\n";
+    os << operation << "_calls_total " << stats.calls << "\n";
+    os << "# TYPE " << operation << "_latency_ns histogram\n";
+    std::uint64_t cumulative{0};
+    for (int bucket = 0; bucket < kHistogramBuckets - 1; ++bucket) {
+      cumulative += stats.latency_histogram[bucket];
+      os << operation << "_latency_ns_bucket{le=\"" << bucketUpperBound(bucket)
+         << "\"} " << cumulative << "\n";
+    }
+    os << operation << "_latency_ns_bucket{le=\"+Inf\"} " << stats.samples
+       << "\n";
+    os << operation << "_latency_ns_sum " << stats.latency_sum << "\n";
+    os << operation << "_latency_ns_count " << stats.samples << "\n";
+  }
+}
+
+namespace detail {
+
+std::uint64_t begin(const Operation operation) {
+  std::atomic<std::uint64_t> &calls{
+      threadCounters().calls[static_cast<int>(operation)]};
+  const std::uint64_t count{calls.load(std::memory_order_relaxed)};
+  calls.store(count + 1, std::memory_order_relaxed);
+  if (count % kSamplingPeriod != 0) {
+    return 0;
+  }
+  // Zero flags unsampled calls, and steady_clock never reads zero in
+  // practice.
+  return now();
+}
+
+void end(const Operation operation, const std::uint64_t start) {
+  const std::uint64_t elapsed{now() - start};
+  ThreadCounters &counters{threadCounters()};
+  const int index{static_cast<int>(operation)};
+  add(counters.histograms[index][bucketOf(elapsed)], 1);
+  add(counters.latency_sums[index], elapsed);
+}
+
+}  // namespace detail
+
+}  // namespace instrumentation
+}  // namespace math
+}  // namespace ekumen
@@ -6,12 +6,457 @@
 
 #include <isometry/isometry.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <isometry/kernels.hpp>
+
 namespace ekumen {
 namespace math {
 
-/*
- * your code here
- */
+namespace {
+
+// The product kernels see vectors and matrices as plain double arrays.
+static_assert(sizeof(Vector3) == 3 * sizeof(double), "Vector3 is padded");
+static_assert(sizeof(Matrix3) == 9 * sizeof(double), "Matrix3 is padded");
+
+// Number of significant digits used when serializing to text.
+const int kStreamPrecision{9};
+
+void checkIndex(const Vector3Batch &batch, const std::size_t index) {
+  if (index >= batch.size()) {
+    throw std::out_of_range("Batch index out of range: " +
+                            std::to_string(index));
+  }
+}
+
+// Squared angle below which the exponential and logarithm maps use Taylor
+// series, truncated so that the first dropped term, at most t^6 / 5040, is
+// below epsilon: they are then as accurate as the closed forms, and avoid
+// their cancellations and divisions by the angle.
+template <typename T>
+T smallAngleThreshold() {
+  static const T threshold{
+      std::cbrt(5040 * std::numeric_limits<T>::epsilon())};
+  return threshold;
+}
+
+// Coefficients of the exponential maps of w, an angle t = |w|. The rotation
+// is R = cos(t) I + a [w]x + b w w', and the translation is V v, with
+// V = I + b [w]x + c [w]x^2.
+template <typename T>
+struct ExpCoefficients {
+  T cos;
+  T a;  // sin(t) / t
+  T b;  // (1 - cos(t)) / t^2
+  T c;  // (t - sin(t)) / t^3
+};
+
+template <typename T>
+ExpCoefficients<T> expCoefficients(const BasicVector3<T> &w) {
+  const T t2{w.dot(w)};
+  if (t2 < smallAngleThreshold<T>()) {
+    const T b{T{1} / T{2} - t2 * (T{1} / T{24} - t2 / T{720})};
+    const T a{T{1} - t2 * (T{1} / T{6} - t2 / T{120})};
+    const T c{T{1} / T{6} - t2 * (T{1} / T{120} - t2 / T{5040})};
+    return ExpCoefficients<T>{T{1} - t2 * b, a, b, c};
+  }
+  const T t{std::sqrt(t2)};
+  const T sin_t{std::sin(t)};
+  const T cos_t{std::cos(t)};
+  return ExpCoefficients<T>{cos_t, sin_t / t, (T{1} - cos_t) / t2,
+                            (t - sin_t) / (t2 * t)};
+}
+
+template <typename T>
+BasicMatrix3<T> rotationExp(const BasicVector3<T> &w,
+                            const ExpCoefficients<T> &k) {
+  const BasicVector3<T> aw{k.a * w};
+  const BasicVector3<T> bw{k.b * w};
+  return BasicMatrix3<T>{
+      k.cos + bw.x() * w.x(),  bw.x() * w.y() - aw.z(), bw.x() * w.z() + aw.y(),
+      bw.y() * w.x() + aw.z(), k.cos + bw.y() * w.y(),  bw.y() * w.z() - aw.x(),
+      bw.z() * w.x() - aw.y(), bw.z() * w.y() + aw.x(), k.cos + bw.z() * w.z()};
+}
+
+// Rotation vector of a rotation. For the closed form, also the angle and
+// its sine and cosine, which the SE(3) logarithm reuses.
+template <typename T>
+struct RotationLog {
+  BasicVector3<T> vector;
+  bool small_angle;
+  T angle;
+  T sin;
+  T cos;
+};
+
+template <typename T>
+RotationLog<T> rotationLog(const BasicMatrix3<T> &r) {
+  // R = cos(t) I + sin(t) [k]x + (1 - cos(t)) k k' for a unit axis k, so the
+  // skew-symmetric part yields sin(t) k and the trace 1 + 2 cos(t).
+  const BasicVector3<T> sin_axis{r.vee()};
+  const T cos_t{(r.element(0, 0) + r.element(1, 1) + r.element(2, 2) - T{1}) /
+                T{2}};
+  const T sin2{sin_axis.dot(sin_axis)};
+  if ((sin2 < smallAngleThreshold<T>()) && (cos_t > T{0})) {
+    // t / sin(t) as the series of asin(x) / x in x = sin(t), which takes
+    // neither the angle nor a square root. Its coefficients decay slower
+    // than those of the exponential, hence the extra term.
+    const T scale{
+        T{1} +
+        sin2 * (T{1} / T{6} +
+                sin2 * (T{3} / T{40} +
+                        sin2 * (T{5} / T{112} + sin2 * T{35} / T{1152})))};
+    return RotationLog<T>{scale * sin_axis, true, T{0}, T{0}, T{0}};
+  }
+  const T sin_t{std::sqrt(sin2)};
+  const T t{std::atan2(sin_t, cos_t)};
+  if (cos_t > T{-0.5}) {
+    return RotationLog<T>{t / sin_t * sin_axis, false, t, sin_t, cos_t};
+  }
+  // Near pi the skew-symmetric part vanishes, so the axis comes from the
+  // symmetric one instead, (1 - cos(t)) k k' = (R + R') / 2 - cos(t) I. Its
+  // column with the largest diagonal element is the best conditioned.
+  int column{0};
+  for (int i = 1; i < 3; ++i) {
+    if (r.element(i, i) > r.element(column, column)) {
+      column = i;
+    }
+  }
+  BasicVector3<T> axis;
+  for (int i = 0; i < 3; ++i) {
+    axis.atUnchecked(i) = (r.element(i, column) + r.element(column, i)) / T{2};
+  }
+  axis.atUnchecked(column) -= cos_t;
+  axis /= axis.norm();
+  // The sign is only lost at pi itself, where both are right.
+  if (axis.dot(sin_axis) < T{0}) {
+    axis *= T{-1};
+  }
+  return RotationLog<T>{t * axis, false, t, sin_t, cos_t};
+}
+
+// Angles per call of the sine and cosine kernel in the batch constructors,
+// small enough for the results to stay on the stack and in L1.
+constexpr std::size_t kSinCosChunk{256};
+
+}  // namespace
+
+void detail::throwIndexOutOfRange(const int index) {
+  throw std::out_of_range("Index out of range: " + std::to_string(index));
+}
+
+template <typename T>
+T BasicVector3<T>::norm() const {
+  return std::sqrt(dot(*this));
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const BasicVector3<T> &v) {
+  const std::streamsize precision{os.precision(kStreamPrecision)};
+  os << "(x: " << v.x() << ", y: " << v.y() << ", z: " << v.z() << ")";
+  os.precision(precision);
+  return os;
+}
+
+template <typename T>
+BasicMatrix3<T> BasicMatrix3<T>::productKernel(const BasicMatrix3 &rhs) const
+  requires std::is_same_v<T, double> {
+  Matrix3 result;
+  kernels::activeKernels().matrix_product(data(), rhs.data(), result.data());
+  return result;
+}
+
+Vector3 detail::productKernel(const Matrix3 &lhs, const Vector3 &rhs) {
+  Vector3 result;
+  kernels::activeKernels().matrix_vector_product(lhs.data(), rhs.data(),
+                                                 result.data());
+  return result;
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const BasicMatrix3<T> &m) {
+  const std::streamsize precision{os.precision(kStreamPrecision)};
+  os << "[";
+  for (int i = 0; i < 3; ++i) {
+    os << (i > 0 ? ", [" : "[") << m.atUnchecked(i, 0) << ", "
+       << m.atUnchecked(i, 1) << ", " << m.atUnchecked(i, 2) << "]";
+  }
+  os << "]";
+  os.precision(precision);
+  return os;
+}
+
+void Vector3Batch::resize(const std::size_t size) {
+  x_.resize(size);
+  y_.resize(size);
+  z_.resize(size);
+}
+
+void Vector3Batch::reserve(const std::size_t capacity) {
+  x_.reserve(capacity);
+  y_.reserve(capacity);
+  z_.reserve(capacity);
+}
+
+void Vector3Batch::clear() {
+  x_.clear();
+  y_.clear();
+  z_.clear();
+}
+
+void Vector3Batch::push_back(const Vector3 &point) {
+  x_.push_back(point.x());
+  y_.push_back(point.y());
+  z_.push_back(point.z());
+}
+
+Vector3 Vector3Batch::get(const std::size_t index) const {
+  checkIndex(*this, index);
+  return Vector3{x_[index], y_[index], z_[index]};
+}
+
+void Vector3Batch::set(const std::size_t index, const Vector3 &point) {
+  checkIndex(*this, index);
+  x_[index] = point.x();
+  y_[index] = point.y();
+  z_[index] = point.z();
+}
+
+template <typename T>
+BasicMatrix3<T> BasicMatrix3<T>::exp(const BasicVector3<T> &rotation_vector) {
+  return rotationExp(rotation_vector, expCoefficients(rotation_vector));
+}
+
+template <typename T>
+BasicVector3<T> BasicMatrix3<T>::log() const {
+  return rotationLog(*this).vector;
+}
+
+template <typename T>
+BasicIsometry<T> BasicIsometry<T>::rotateAround(const BasicVector3<T> &axis,
+                                                const T angle) {
+  const T axis_norm{axis.norm()};
+  if (axis_norm == T{0}) {
+    throw std::invalid_argument("The rotation axis can't be a null vector");
+  }
+  // Rodrigues' rotation formula, R = cos(a) I + sin(a) [k]x + (1 - cos(a)) kk'
+  const BasicVector3<T> k{axis / axis_norm};
+  const T c{std::cos(angle)};
+  const T s{std::sin(angle)};
+  const BasicMatrix3<T> k_cross{T{0},   -k.z(), k.y(),  k.z(), T{0},
+                                -k.x(), -k.y(), k.x(), T{0}};
+  const BasicMatrix3<T> k_outer{k.x() * k, k.y() * k, k.z() * k};
+  return BasicIsometry{BasicVector3<T>::kZero,
+                       c * BasicMatrix3<T>::kIdentity + s * k_cross +
+                           (T{1} - c) * k_outer};
+}
+
+template <typename T>
+BasicIsometry<T> BasicIsometry<T>::fromEulerAngles(const T roll,
+                                                   const T pitch,
+                                                   const T yaw) {
+  return fromEulerAngles<EulerConvention::kIntrinsicXYZ>(roll, pitch, yaw);
+}
+
+template <typename T>
+BasicIsometry<T> BasicIsometry<T>::exp(const BasicTwist<T> &twist) {
+  const BasicVector3<T> &v{twist.linear};
+  const BasicVector3<T> &w{twist.angular};
+  const ExpCoefficients<T> k{expCoefficients(w)};
+  const BasicVector3<T> w_v{w.cross(v)};
+  return BasicIsometry{v + k.b * w_v + k.c * w.cross(w_v), rotationExp(w, k)};
+}
+
+template <typename T>
+void BasicIsometry<T>::exp(std::span<const BasicTwist<T>> twists,
+                           std::span<BasicIsometry> isometries) {
+  if (twists.size() != isometries.size()) {
+    throw std::invalid_argument("Input and output sizes differ");
+  }
+  for (std::size_t i = 0; i < twists.size(); ++i) {
+    isometries[i] = exp(twists[i]);
+  }
+}
+
+template <typename T>
+BasicTwist<T> BasicIsometry<T>::log() const {
+  const RotationLog<T> rotation_log{rotationLog(rotation_)};
+  const BasicVector3<T> &w{rotation_log.vector};
+  // V^-1 = I - [w]x / 2 + d [w]x^2, d = (1 - t sin(t) / (2 (1 - cos(t)))) /
+  // t^2. Away from pi, 1 - cos(t) is taken as sin(t)^2 / (1 + cos(t)), which
+  // does not cancel for small angles.
+  T d;
+  if (rotation_log.small_angle) {
+    const T t2{w.dot(w)};
+    d = T{1} / T{12} + t2 * (T{1} / T{720} + t2 / T{30240});
+  } else {
+    const T t{rotation_log.angle};
+    const T sin_t{rotation_log.sin};
+    const T cos_t{rotation_log.cos};
+    d = (T{1} - (cos_t > T{0} ? t * (T{1} + cos_t) / (T{2} * sin_t)
+                              : t * sin_t / (T{2} * (T{1} - cos_t)))) /
+        (t * t);
+  }
+  const BasicVector3<T> w_t{w.cross(translation_)};
+  return BasicTwist<T>{translation_ - w_t / T{2} + d * w.cross(w_t), w};
+}
+
+template <typename T>
+void BasicIsometry<T>::log(std::span<const BasicIsometry> isometries,
+                           std::span<BasicTwist<T>> twists) {
+  if (isometries.size() != twists.size()) {
+    throw std::invalid_argument("Input and output sizes differ");
+  }
+  for (std::size_t i = 0; i < isometries.size(); ++i) {
+    twists[i] = isometries[i].log();
+  }
+}
+
+template <typename T>
+void BasicIsometry<T>::rotateAround(const BasicVector3<T> &axis,
+                                    std::span<const T> angles,
+                                    std::span<BasicIsometry> isometries)
+  requires std::is_same_v<T, double> {
+  if (angles.size() != isometries.size()) {
+    throw std::invalid_argument("Input and output sizes differ");
+  }
+  const double axis_norm{axis.norm()};
+  if (axis_norm == 0.) {
+    throw std::invalid_argument("The rotation axis can't be a null vector");
+  }
+  // Same Rodrigues' formula as the single form, with the axis terms hoisted.
+  const Vector3 k{axis / axis_norm};
+  const Matrix3 k_cross{0.,     -k.z(), k.y(),  k.z(), 0.,
+                        -k.x(), -k.y(), k.x(), 0.};
+  const Matrix3 k_outer{k.x() * k, k.y() * k, k.z() * k};
+  const kernels::SinCosKernel sincos{kernels::activeKernels().sincos};
+  double sines[kSinCosChunk];
+  double cosines[kSinCosChunk];
+  for (std::size_t begin = 0; begin < angles.size(); begin += kSinCosChunk) {
+    const std::size_t size{std::min(kSinCosChunk, angles.size() - begin)};
+    sincos(angles.data() + begin, size, sines, cosines);
+    for (std::size_t i = 0; i < size; ++i) {
+      const double c{cosines[i]};
+      isometries[begin + i] = BasicIsometry{
+          Vector3::kZero,
+          c * Matrix3::kIdentity + sines[i] * k_cross + (1. - c) * k_outer};
+    }
+  }
+}
+
+template <typename T>
+void BasicIsometry<T>::fromEulerAngles(std::span<const T> roll,
+                                       std::span<const T> pitch,
+                                       std::span<const T> yaw,
+                                       std::span<BasicIsometry> isometries)
+  requires std::is_same_v<T, double> {
+  if ((roll.size() != isometries.size()) ||
+      (pitch.size() != isometries.size()) ||
+      (yaw.size() != isometries.size())) {
+    throw std::invalid_argument("Input and output sizes differ");
+  }
+  const kernels::SinCosKernel sincos{kernels::activeKernels().sincos};
+  double sr[kSinCosChunk], cr[kSinCosChunk];
+  double sp[kSinCosChunk], cp[kSinCosChunk];
+  double sy[kSinCosChunk], cy[kSinCosChunk];
+  for (std::size_t begin = 0; begin < roll.size(); begin += kSinCosChunk) {
+    const std::size_t size{std::min(kSinCosChunk, roll.size() - begin)};
+    sincos(roll.data() + begin, size, sr, cr);
+    sincos(pitch.data() + begin, size, sp, cp);
+    sincos(yaw.data() + begin, size, sy, cy);
+    for (std::size_t i = 0; i < size; ++i) {
+      isometries[begin + i] = BasicIsometry{
+          Vector3::kZero,
+          detail::eulerRotation<EulerConvention::kIntrinsicXYZ>(
+              sr[i], cr[i], sp[i], cp[i], sy[i], cy[i])};
+    }
+  }
+}
+
+template <typename T>
+void BasicIsometry<T>::transform(const Vector3Batch &input,
+                                 Vector3Batch &output) const
+  requires std::is_same_v<T, double> {
+  if (&input == &output) {
+    transform(output);
+    return;
+  }
+  output.resize(input.size());
+  const double *r{rotation_.data()};
+  const double r00{r[0]}, r01{r[1]}, r02{r[2]};
+  const double r10{r[3]}, r11{r[4]}, r12{r[5]};
+  const double r20{r[6]}, r21{r[7]}, r22{r[8]};
+  const double tx{translation_.x()}, ty{translation_.y()}, tz{translation_.z()};
+  const double *__restrict__ in_x{input.x()};
+  const double *__restrict__ in_y{input.y()};
+  const double *__restrict__ in_z{input.z()};
+  double *__restrict__ out_x{output.x()};
+  double *__restrict__ out_y{output.y()};
+  double *__restrict__ out_z{output.z()};
+  const std::size_t size{input.size()};
+  for (std::size_t i = 0; i < size; ++i) {
+    const double x{in_x[i]}, y{in_y[i]}, z{in_z[i]};
+    out_x[i] = r00 * x + r01 * y + r02 * z + tx;
+    out_y[i] = r10 * x + r11 * y + r12 * z + ty;
+    out_z[i] = r20 * x + r21 * y + r22 * z + tz;
+  }
+}
+
+template <typename T>
+void BasicIsometry<T>::transform(Vector3Batch &points) const
+  requires std::is_same_v<T, double> {
+  const double *r{rotation_.data()};
+  const double r00{r[0]}, r01{r[1]}, r02{r[2]};
+  const double r10{r[3]}, r11{r[4]}, r12{r[5]};
+  const double r20{r[6]}, r21{r[7]}, r22{r[8]};
+  const double tx{translation_.x()}, ty{translation_.y()}, tz{translation_.z()};
+  double *__restrict__ px{points.x()};
+  double *__restrict__ py{points.y()};
+  double *__restrict__ pz{points.z()};
+  const std::size_t size{points.size()};
+  for (std::size_t i = 0; i < size; ++i) {
+    const double x{px[i]}, y{py[i]}, z{pz[i]};
+    px[i] = r00 * x + r01 * y + r02 * z + tx;
+    py[i] = r10 * x + r11 * y + r12 * z + ty;
+    pz[i] = r20 * x + r21 * y + r22 * z + tz;
+  }
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const BasicIsometry<T> &t) {
+  return os << "[T: " << t.translation() << ", R:" << t.rotation() << "]";
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const BasicTwist<T> &t) {
+  return os << "[v: " << t.linear << ", w: " << t.angular << "]";
+}
+
+template class BasicVector3<float>;
+template class BasicVector3<double>;
+template class BasicVector3<long double>;
+template class BasicMatrix3<float>;
+template class BasicMatrix3<double>;
+template class BasicMatrix3<long double>;
+template class BasicIsometry<float>;
+template class BasicIsometry<double>;
+template class BasicIsometry<long double>;
+
+template std::ostream &operator<<(std::ostream &, const Vector3f &);
+template std::ostream &operator<<(std::ostream &, const Vector3 &);
+template std::ostream &operator<<(std::ostream &, const Vector3l &);
+template std::ostream &operator<<(std::ostream &, const Matrix3f &);
+template std::ostream &operator<<(std::ostream &, const Matrix3 &);
+template std::ostream &operator<<(std::ostream &, const Matrix3l &);
+template std::ostream &operator<<(std::ostream &, const Isometryf &);
+template std::ostream &operator<<(std::ostream &, const Isometry &);
+template std::ostream &operator<<(std::ostream &, const Isometryl &);
+template std::ostream &operator<<(std::ostream &, const Twistf &);
+template std::ostream &operator<<(std::ostream &, const Twist &);
+template std::ostream &operator<<(std::ostream &, const Twistl &);
 
 }  // namespace math
 }  // namespace ekumen
@@ -0,0 +1,585 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/kernels.hpp>
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ISOMETRY_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace ekumen {
+namespace math {
+namespace kernels {
+
+namespace {
+
+void matrixProductScalar(const double *lhs, const double *rhs,
+                         double *result) {
+  for (int i = 0; i < 3; ++i) {
+    const double *row{lhs + 3 * i};
+    for (int j = 0; j < 3; ++j) {
+      result[3 * i + j] =
+          row[0] * rhs[j] + row[1] * rhs[3 + j] + row[2] * rhs[6 + j];
+    }
+  }
+}
+
+void matrixVectorProductScalar(const double *lhs, const double *rhs,
+                               double *result) {
+  for (int i = 0; i < 3; ++i) {
+    const double *row{lhs + 3 * i};
+    result[i] = row[0] * rhs[0] + row[1] * rhs[1] + row[2] * rhs[2];
+  }
+}
+
+void alignedMatrixProductScalar(const double *lhs, const double *rhs,
+                                double *result) {
+  for (int i = 0; i < 3; ++i) {
+    const double *row{lhs + 4 * i};
+    for (int j = 0; j < 3; ++j) {
+      result[4 * i + j] =
+          row[0] * rhs[j] + row[1] * rhs[4 + j] + row[2] * rhs[8 + j];
+    }
+    result[4 * i + 3] = 0.;
+  }
+}
+
+void alignedMatrixVectorProductScalar(const double *lhs, const double *rhs,
+                                      double *result) {
+  for (int i = 0; i < 3; ++i) {
+    const double *row{lhs + 4 * i};
+    result[i] = row[0] * rhs[0] + row[1] * rhs[1] + row[2] * rhs[2];
+  }
+  result[3] = 0.;
+}
+
+// Argument reduction constants. pi/2 is split in four parts, the first
+// three with 33 significant bits, so that their products by quadrant numbers
+// below 2^20 are exact.
+constexpr double kTwoOverPi{0x1.45f306dc9c883p-1};
+constexpr double kPiOverTwo1{0x1.921fb544p+0};
+constexpr double kPiOverTwo2{0x1.0b4611a6p-34};
+constexpr double kPiOverTwo3{0x1.3198a2ep-69};
+constexpr double kPiOverTwo4{0x1.b839a252049c1p-104};
+// Adding 1.5 * 2^52 rounds to an integer, which is left in the low bits of
+// the mantissa.
+constexpr double kRoundingShifter{0x1.8p52};
+
+// Minimax polynomials of sin and cos over [-pi/4, pi/4], from fdlibm.
+constexpr double kSin1{-1.66666666666666324348e-01};
+constexpr double kSin2{8.33333333332248946124e-03};
+constexpr double kSin3{-1.98412698298579493134e-04};
+constexpr double kSin4{2.75573137070700676789e-06};
+constexpr double kSin5{-2.50507602534068634195e-08};
+constexpr double kSin6{1.58969099521155010221e-10};
+constexpr double kCos1{4.16666666666666019037e-02};
+constexpr double kCos2{-1.38888888888741095749e-03};
+constexpr double kCos3{2.48015872894767294178e-05};
+constexpr double kCos4{-2.75573143513906633035e-07};
+constexpr double kCos5{2.08757232129817482790e-09};
+constexpr double kCos6{-1.13596475577881948265e-11};
+
+// a + b as an unevaluated sum of the rounded result and its rounding error.
+void twoSum(const double a, const double b, double &sum, double &error) {
+  sum = a + b;
+  const double b_part{sum - a};
+  error = (a - (sum - b_part)) + (b - b_part);
+}
+
+// Every variant evaluates exactly these operations, in this order. The
+// reduced angle is carried as a head and a tail, which the polynomials take
+// into account as fdlibm's kernels do.
+void sinCosScalar(const double angle, double *sine, double *cosine) {
+  if (!(std::abs(angle) <= kSinCosRange)) {
+    *sine = std::sin(angle);
+    *cosine = std::cos(angle);
+    return;
+  }
+  const double shifted{angle * kTwoOverPi + kRoundingShifter};
+  const double quadrant{shifted - kRoundingShifter};
+  // Exact, as the product is, and the difference is at most half of either.
+  const double r1{angle - quadrant * kPiOverTwo1};
+  double r2, e2, r3, e3, x, y;
+  twoSum(r1, -(quadrant * kPiOverTwo2), r2, e2);
+  twoSum(r2, -(quadrant * kPiOverTwo3), r3, e3);
+  twoSum(r3, (e2 + e3) - quadrant * kPiOverTwo4, x, y);
+
+  const double z{x * x};
+  const double v{z * x};
+  const double p{
+      kSin2 + z * (kSin3 + z * (kSin4 + z * (kSin5 + z * kSin6)))};
+  const double s{x - ((z * (0.5 * y - v * p) - y) - v * kSin1)};
+  const double q{
+      z *
+      (kCos1 +
+       z * (kCos2 + z * (kCos3 + z * (kCos4 + z * (kCos5 + z * kCos6)))))};
+  const double half_z{0.5 * z};
+  const double w{1. - half_z};
+  const double c{w + (((1. - w) - half_z) + (z * q - x * y))};
+
+  const std::uint64_t k{std::bit_cast<std::uint64_t>(shifted)};
+  const bool swap{(k & 1) != 0};
+  *sine = ((k & 2) != 0) ? -(swap ? c : s) : (swap ? c : s);
+  *cosine = (((k + 1) & 2) != 0) ? -(swap ? s : c) : (swap ? s : c);
+}
+
+void sinCosScalar(const double *angles, const std::size_t count,
+                  double *sines, double *cosines) {
+  for (std::size_t i = 0; i < count; ++i) {
+    sinCosScalar(angles[i], sines + i, cosines + i);
+  }
+}
+
+#ifdef ISOMETRY_X86_KERNELS
+
+// Two lanes hold the first two columns of each result row, and the third
+// column is computed on the scalar unit.
+__attribute__((target("sse2"))) void matrixProductSse2(const double *lhs,
+                                                       const double *rhs,
+                                                       double *result) {
+  const __m128d b0{_mm_loadu_pd(rhs)};
+  const __m128d b1{_mm_loadu_pd(rhs + 3)};
+  const __m128d b2{_mm_loadu_pd(rhs + 6)};
+  for (int i = 0; i < 3; ++i) {
+    const double *row{lhs + 3 * i};
+    const __m128d sum{_mm_add_pd(
+        _mm_add_pd(_mm_mul_pd(_mm_set1_pd(row[0]), b0),
+                   _mm_mul_pd(_mm_set1_pd(row[1]), b1)),
+        _mm_mul_pd(_mm_set1_pd(row[2]), b2))};
+    _mm_storeu_pd(result + 3 * i, sum);
+    result[3 * i + 2] = row[0] * rhs[2] + row[1] * rhs[5] + row[2] * rhs[8];
+  }
+}
+
+__attribute__((target("sse2"))) void matrixVectorProductSse2(
+    const double *lhs, const double *rhs, double *result) {
+  const __m128d c0{_mm_set_pd(lhs[3], lhs[0])};
+  const __m128d c1{_mm_set_pd(lhs[4], lhs[1])};
+  const __m128d c2{_mm_set_pd(lhs[5], lhs[2])};
+  const __m128d sum{
+      _mm_add_pd(_mm_add_pd(_mm_mul_pd(c0, _mm_set1_pd(rhs[0])),
+                            _mm_mul_pd(c1, _mm_set1_pd(rhs[1]))),
+                 _mm_mul_pd(c2, _mm_set1_pd(rhs[2])))};
+  _mm_storeu_pd(result, sum);
+  result[2] = lhs[6] * rhs[0] + lhs[7] * rhs[1] + lhs[8] * rhs[2];
+}
+
+// Rows are loaded and stored with a three lane mask, so nothing is read or
+// written past the end of the operands.
+__attribute__((target("avx2"))) void matrixProductAvx2(const double *lhs,
+                                                       const double *rhs,
+                                                       double *result) {
+  const __m256i mask{_mm256_set_epi64x(0, -1, -1, -1)};
+  const __m256d b0{_mm256_maskload_pd(rhs, mask)};
+  const __m256d b1{_mm256_maskload_pd(rhs + 3, mask)};
+  const __m256d b2{_mm256_maskload_pd(rhs + 6, mask)};
+  for (int i = 0; i < 3; ++i) {
+    const double *row{lhs + 3 * i};
+    const __m256d sum{_mm256_add_pd(
+        _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(row[0]), b0),
+                      _mm256_mul_pd(_mm256_set1_pd(row[1]), b1)),
+        _mm256_mul_pd(_mm256_set1_pd(row[2]), b2))};
+    _mm256_maskstore_pd(result + 3 * i, mask, sum);
+  }
+}
+
+__attribute__((target("avx2"))) void matrixVectorProductAvx2(
+    const double *lhs, const double *rhs, double *result) {
+  const __m256i mask{_mm256_set_epi64x(0, -1, -1, -1)};
+  const __m256d c0{_mm256_set_pd(0., lhs[6], lhs[3], lhs[0])};
+  const __m256d c1{_mm256_set_pd(0., lhs[7], lhs[4], lhs[1])};
+  const __m256d c2{_mm256_set_pd(0., lhs[8], lhs[5], lhs[2])};
+  const __m256d sum{_mm256_add_pd(
+      _mm256_add_pd(_mm256_mul_pd(c0, _mm256_set1_pd(rhs[0])),
+                    _mm256_mul_pd(c1, _mm256_set1_pd(rhs[1]))),
+      _mm256_mul_pd(c2, _mm256_set1_pd(rhs[2])))};
+  _mm256_maskstore_pd(result, mask, sum);
+}
+
+// Padded rows are two registers each, so every lane of the result is
+// computed on the vector unit, except for the padding, which is cleared:
+// computing it would give NaN for infinite elements, and -0 for negative ones.
+__attribute__((target("sse2"))) void alignedMatrixProductSse2(
+    const double *lhs, const double *rhs, double *result) {
+  for (int half = 0; half < 4; half += 2) {
+    const __m128d b0{_mm_load_pd(rhs + half)};
+    const __m128d b1{_mm_load_pd(rhs + 4 + half)};
+    const __m128d b2{_mm_load_pd(rhs + 8 + half)};
+    for (int i = 0; i < 3; ++i) {
+      const double *row{lhs + 4 * i};
+      __m128d sum{_mm_add_pd(
+          _mm_add_pd(_mm_mul_pd(_mm_set1_pd(row[0]), b0),
+                     _mm_mul_pd(_mm_set1_pd(row[1]), b1)),
+          _mm_mul_pd(_mm_set1_pd(row[2]), b2))};
+      if (half == 2) {
+        sum = _mm_unpacklo_pd(sum, _mm_setzero_pd());
+      }
+      _mm_store_pd(result + 4 * i + half, sum);
+    }
+  }
+}
+
+// The first two elements of the result are the row sums of the element-wise
+// products of the first two rows and the vector, added pairwise after an
+// unpack. The third one is computed on the scalar unit.
+__attribute__((target("sse2"))) void alignedMatrixVectorProductSse2(
+    const double *lhs, const double *rhs, double *result) {
+  const __m128d v_low{_mm_load_pd(rhs)};
+  const __m128d v_high{_mm_load_pd(rhs + 2)};
+  const __m128d p0_low{_mm_mul_pd(_mm_load_pd(lhs), v_low)};
+  const __m128d p0_high{_mm_mul_pd(_mm_load_pd(lhs + 2), v_high)};
+  const __m128d p1_low{_mm_mul_pd(_mm_load_pd(lhs + 4), v_low)};
+  const __m128d p1_high{_mm_mul_pd(_mm_load_pd(lhs + 6), v_high)};
+  const __m128d sum{_mm_add_pd(
+      _mm_add_pd(_mm_unpacklo_pd(p0_low, p1_low),
+                 _mm_unpackhi_pd(p0_low, p1_low)),
+      _mm_unpacklo_pd(p0_high, p1_high))};
+  _mm_store_pd(result, sum);
+  _mm_store_pd(result + 2,
+               _mm_set_pd(0., lhs[8] * rhs[0] + lhs[9] * rhs[1] +
+                                  lhs[10] * rhs[2]));
+}
+
+// The padding lane is cleared, as in the SSE2 kernel.
+__attribute__((target("avx2"))) void alignedMatrixProductAvx2(
+    const double *lhs, const double *rhs, double *result) {
+  const __m256d b0{_mm256_load_pd(rhs)};
+  const __m256d b1{_mm256_load_pd(rhs + 4)};
+  const __m256d b2{_mm256_load_pd(rhs + 8)};
+  for (int i = 0; i < 3; ++i) {
+    const double *row{lhs + 4 * i};
+    const __m256d sum{_mm256_add_pd(
+        _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(row[0]), b0),
+                      _mm256_mul_pd(_mm256_set1_pd(row[1]), b1)),
+        _mm256_mul_pd(_mm256_set1_pd(row[2]), b2))};
+    _mm256_store_pd(result + 4 * i,
+                    _mm256_blend_pd(sum, _mm256_setzero_pd(), 0b1000));
+  }
+}
+
+// Rows are multiplied by the vector element-wise. The first two products of
+// each row are added with horizontal adds, and the third ones gathered with
+// unpacks and lane swaps, so that each element adds up as
+// (a0 * b0 + a1 * b1) + a2 * b2 and the padding products are never used.
+__attribute__((target("avx2"))) void alignedMatrixVectorProductAvx2(
+    const double *lhs, const double *rhs, double *result) {
+  const __m256d v{_mm256_load_pd(rhs)};
+  const __m256d p0{_mm256_mul_pd(_mm256_load_pd(lhs), v)};
+  const __m256d p1{_mm256_mul_pd(_mm256_load_pd(lhs + 4), v)};
+  const __m256d p2{_mm256_mul_pd(_mm256_load_pd(lhs + 8), v)};
+  // (p0[0] + p0[1], p1[0] + p1[1], p2[0] + p2[1], p2[0] + p2[1])
+  const __m256d pairs{_mm256_permute2f128_pd(_mm256_hadd_pd(p0, p1),
+                                             _mm256_hadd_pd(p2, p2), 0x20)};
+  // (p0[2], p1[2], p2[2], 0)
+  const __m256d thirds{_mm256_permute2f128_pd(
+      _mm256_unpacklo_pd(p0, p1),
+      _mm256_unpacklo_pd(p2, _mm256_setzero_pd()), 0x31)};
+  _mm256_store_pd(result, _mm256_blend_pd(_mm256_add_pd(pairs, thirds),
+                                          _mm256_setzero_pd(), 0b1000));
+}
+
+// Permutation indices mapping each of the first eight elements of the
+// result to the operand elements it needs for each of the three terms of
+// the sum. Index 8 refers to the ninth element, held in a second register.
+alignas(64) const long long kLhsIndices[3][8] = {{0, 0, 0, 3, 3, 3, 6, 6},
+                                                 {1, 1, 1, 4, 4, 4, 7, 7},
+                                                 {2, 2, 2, 5, 5, 5, 8, 8}};
+alignas(64) const long long kRhsIndices[3][8] = {{0, 1, 2, 0, 1, 2, 0, 1},
+                                                 {3, 4, 5, 3, 4, 5, 3, 4},
+                                                 {6, 7, 8, 6, 7, 8, 6, 7}};
+
+// Eight of the nine elements of the result are computed in a single register,
+// the last one is computed on the scalar unit.
+__attribute__((target("avx512f"))) void matrixProductAvx512(const double *lhs,
+                                                           const double *rhs,
+                                                           double *result) {
+  const __m512d a_low{_mm512_loadu_pd(lhs)};
+  const __m512d a_high{_mm512_set1_pd(lhs[8])};
+  const __m512d b_low{_mm512_loadu_pd(rhs)};
+  const __m512d b_high{_mm512_set1_pd(rhs[8])};
+  __m512d terms[3];
+  for (int k = 0; k < 3; ++k) {
+    const __m512d a{_mm512_permutex2var_pd(
+        a_low, _mm512_load_si512(kLhsIndices[k]), a_high)};
+    const __m512d b{_mm512_permutex2var_pd(
+        b_low, _mm512_load_si512(kRhsIndices[k]), b_high)};
+    terms[k] = _mm512_mul_pd(a, b);
+  }
+  _mm512_storeu_pd(result,
+                   _mm512_add_pd(_mm512_add_pd(terms[0], terms[1]), terms[2]));
+  result[8] = lhs[6] * rhs[2] + lhs[7] * rhs[5] + lhs[8] * rhs[8];
+}
+
+__attribute__((target("sse2"))) void twoSumSse2(const __m128d a,
+                                                const __m128d b, __m128d &sum,
+                                                __m128d &error) {
+  sum = _mm_add_pd(a, b);
+  const __m128d b_part{_mm_sub_pd(sum, a)};
+  error = _mm_add_pd(_mm_sub_pd(a, _mm_sub_pd(sum, b_part)),
+                     _mm_sub_pd(b, b_part));
+}
+
+// Lane-wise sinCosScalar(). Groups with an angle out of range take the
+// scalar path whole. The quadrant selects between the polynomials with a
+// blend and flips signs with an exclusive or.
+__attribute__((target("sse2"))) void sinCosSse2(const double *angles,
+                                                const std::size_t count,
+                                                double *sines,
+                                                double *cosines) {
+  const __m128d sign_mask{_mm_set1_pd(-0.)};
+  const __m128d half{_mm_set1_pd(0.5)};
+  const __m128d one{_mm_set1_pd(1.)};
+  const __m128i one_bit{_mm_set1_epi64x(1)};
+  const __m128i two_bit{_mm_set1_epi64x(2)};
+  std::size_t i{0};
+  for (; i + 2 <= count; i += 2) {
+    const __m128d angle{_mm_loadu_pd(angles + i)};
+    const __m128d in_range{_mm_cmple_pd(_mm_andnot_pd(sign_mask, angle),
+                                        _mm_set1_pd(kSinCosRange))};
+    if (_mm_movemask_pd(in_range) != 0b11) {
+      sinCosScalar(angles + i, 2, sines + i, cosines + i);
+      continue;
+    }
+    const __m128d shifted{
+        _mm_add_pd(_mm_mul_pd(angle, _mm_set1_pd(kTwoOverPi)),
+                   _mm_set1_pd(kRoundingShifter))};
+    const __m128d quadrant{
+        _mm_sub_pd(shifted, _mm_set1_pd(kRoundingShifter))};
+    const __m128d r1{_mm_sub_pd(
+        angle, _mm_mul_pd(quadrant, _mm_set1_pd(kPiOverTwo1)))};
+    __m128d r2, e2, r3, e3, x, y;
+    twoSumSse2(r1,
+               _mm_xor_pd(sign_mask,
+                          _mm_mul_pd(quadrant, _mm_set1_pd(kPiOverTwo2))),
+               r2, e2);
+    twoSumSse2(r2,
+               _mm_xor_pd(sign_mask,
+                          _mm_mul_pd(quadrant, _mm_set1_pd(kPiOverTwo3))),
+               r3, e3);
+    twoSumSse2(r3,
+               _mm_sub_pd(_mm_add_pd(e2, e3),
+                          _mm_mul_pd(quadrant, _mm_set1_pd(kPiOverTwo4))),
+               x, y);
+
+    const __m128d z{_mm_mul_pd(x, x)};
+    const __m128d v{_mm_mul_pd(z, x)};
+    __m128d p{_mm_set1_pd(kSin6)};
+    p = _mm_add_pd(_mm_set1_pd(kSin5), _mm_mul_pd(z, p));
+    p = _mm_add_pd(_mm_set1_pd(kSin4), _mm_mul_pd(z, p));
+    p = _mm_add_pd(_mm_set1_pd(kSin3), _mm_mul_pd(z, p));
+    p = _mm_add_pd(_mm_set1_pd(kSin2), _mm_mul_pd(z, p));
+    const __m128d s{_mm_sub_pd(
+        x, _mm_sub_pd(_mm_sub_pd(_mm_mul_pd(z, _mm_sub_pd(_mm_mul_pd(half, y),
+                                                          _mm_mul_pd(v, p))),
+                                 y),
+                      _mm_mul_pd(v, _mm_set1_pd(kSin1))))};
+
+    __m128d q{_mm_set1_pd(kCos6)};
+    q = _mm_add_pd(_mm_set1_pd(kCos5), _mm_mul_pd(z, q));
+    q = _mm_add_pd(_mm_set1_pd(kCos4), _mm_mul_pd(z, q));
+    q = _mm_add_pd(_mm_set1_pd(kCos3), _mm_mul_pd(z, q));
+    q = _mm_add_pd(_mm_set1_pd(kCos2), _mm_mul_pd(z, q));
+    q = _mm_add_pd(_mm_set1_pd(kCos1), _mm_mul_pd(z, q));
+    q = _mm_mul_pd(z, q);
+    const __m128d half_z{_mm_mul_pd(half, z)};
+    const __m128d w{_mm_sub_pd(one, half_z)};
+    const __m128d c{_mm_add_pd(
+        w, _mm_add_pd(_mm_sub_pd(_mm_sub_pd(one, w), half_z),
+                      _mm_sub_pd(_mm_mul_pd(z, q), _mm_mul_pd(x, y))))};
+
+    const __m128i k{_mm_castpd_si128(shifted)};
+    // SSE2 has no 64-bit compare: 0 - (k & 1) is all ones for odd k.
+    const __m128d swap{_mm_castsi128_pd(
+        _mm_sub_epi64(_mm_setzero_si128(), _mm_and_si128(k, one_bit)))};
+    const __m128d sine{_mm_or_pd(_mm_and_pd(swap, c), _mm_andnot_pd(swap, s))};
+    const __m128d cosine{
+        _mm_or_pd(_mm_and_pd(swap, s), _mm_andnot_pd(swap, c))};
+    const __m128d sine_sign{
+        _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(k, two_bit), 62))};
+    const __m128d cosine_sign{_mm_castsi128_pd(_mm_slli_epi64(
+        _mm_and_si128(_mm_add_epi64(k, one_bit), two_bit), 62))};
+    _mm_storeu_pd(sines + i, _mm_xor_pd(sine, sine_sign));
+    _mm_storeu_pd(cosines + i, _mm_xor_pd(cosine, cosine_sign));
+  }
+  sinCosScalar(angles + i, count - i, sines + i, cosines + i);
+}
+
+__attribute__((target("avx2"))) void twoSumAvx2(const __m256d a,
+                                                const __m256d b, __m256d &sum,
+                                                __m256d &error) {
+  sum = _mm256_add_pd(a, b);
+  const __m256d b_part{_mm256_sub_pd(sum, a)};
+  error = _mm256_add_pd(_mm256_sub_pd(a, _mm256_sub_pd(sum, b_part)),
+                        _mm256_sub_pd(b, b_part));
+}
+
+__attribute__((target("avx2"))) void sinCosAvx2(const double *angles,
+                                                const std::size_t count,
+                                                double *sines,
+                                                double *cosines) {
+  const __m256d sign_mask{_mm256_set1_pd(-0.)};
+  const __m256d half{_mm256_set1_pd(0.5)};
+  const __m256d one{_mm256_set1_pd(1.)};
+  const __m256i one_bit{_mm256_set1_epi64x(1)};
+  const __m256i two_bit{_mm256_set1_epi64x(2)};
+  std::size_t i{0};
+  for (; i + 4 <= count; i += 4) {
+    const __m256d angle{_mm256_loadu_pd(angles + i)};
+    const __m256d in_range{
+        _mm256_cmp_pd(_mm256_andnot_pd(sign_mask, angle),
+                      _mm256_set1_pd(kSinCosRange), _CMP_LE_OQ)};
+    if (_mm256_movemask_pd(in_range) != 0b1111) {
+      sinCosScalar(angles + i, 4, sines + i, cosines + i);
+      continue;
+    }
+    const __m256d shifted{
+        _mm256_add_pd(_mm256_mul_pd(angle, _mm256_set1_pd(kTwoOverPi)),
+                      _mm256_set1_pd(kRoundingShifter))};
+    const __m256d quadrant{
+        _mm256_sub_pd(shifted, _mm256_set1_pd(kRoundingShifter))};
+    const __m256d r1{_mm256_sub_pd(
+        angle, _mm256_mul_pd(quadrant, _mm256_set1_pd(kPiOverTwo1)))};
+    __m256d r2, e2, r3, e3, x, y;
+    twoSumAvx2(r1,
+               _mm256_xor_pd(sign_mask, _mm256_mul_pd(
+                                            quadrant,
+                                            _mm256_set1_pd(kPiOverTwo2))),
+               r2, e2);
+    twoSumAvx2(r2,
+               _mm256_xor_pd(sign_mask, _mm256_mul_pd(
+                                            quadrant,
+                                            _mm256_set1_pd(kPiOverTwo3))),
+               r3, e3);
+    twoSumAvx2(r3,
+               _mm256_sub_pd(_mm256_add_pd(e2, e3),
+                             _mm256_mul_pd(quadrant,
+                                           _mm256_set1_pd(kPiOverTwo4))),
+               x, y);
+
+    const __m256d z{_mm256_mul_pd(x, x)};
+    const __m256d v{_mm256_mul_pd(z, x)};
+    __m256d p{_mm256_set1_pd(kSin6)};
+    p = _mm256_add_pd(_mm256_set1_pd(kSin5), _mm256_mul_pd(z, p));
+    p = _mm256_add_pd(_mm256_set1_pd(kSin4), _mm256_mul_pd(z, p));
+    p = _mm256_add_pd(_mm256_set1_pd(kSin3), _mm256_mul_pd(z, p));
+    p = _mm256_add_pd(_mm256_set1_pd(kSin2), _mm256_mul_pd(z, p));
+    const __m256d s{_mm256_sub_pd(
+        x, _mm256_sub_pd(
+               _mm256_sub_pd(
+                   _mm256_mul_pd(z, _mm256_sub_pd(_mm256_mul_pd(half, y),
+                                                  _mm256_mul_pd(v, p))),
+                   y),
+               _mm256_mul_pd(v, _mm256_set1_pd(kSin1))))};
+
+    __m256d q{_mm256_set1_pd(kCos6)};
+    q = _mm256_add_pd(_mm256_set1_pd(kCos5), _mm256_mul_pd(z, q));
+    q = _mm256_add_pd(_mm256_set1_pd(kCos4), _mm256_mul_pd(z, q));
+    q = _mm256_add_pd(_mm256_set1_pd(kCos3), _mm256_mul_pd(z, q));
+    q = _mm256_add_pd(_mm256_set1_pd(kCos2), _mm256_mul_pd(z, q));
+    q = _mm256_add_pd(_mm256_set1_pd(kCos1), _mm256_mul_pd(z, q));
+    q = _mm256_mul_pd(z, q);
+    const __m256d half_z{_mm256_mul_pd(half, z)};
+    const __m256d w{_mm256_sub_pd(one, half_z)};
+    const __m256d c{_mm256_add_pd(
+        w, _mm256_add_pd(_mm256_sub_pd(_mm256_sub_pd(one, w), half_z),
+                         _mm256_sub_pd(_mm256_mul_pd(z, q),
+                                       _mm256_mul_pd(x, y))))};
+
+    const __m256i k{_mm256_castpd_si256(shifted)};
+    const __m256d swap{_mm256_castsi256_pd(
+        _mm256_cmpeq_epi64(_mm256_and_si256(k, one_bit), one_bit))};
+    const __m256d sine{_mm256_blendv_pd(s, c, swap)};
+    const __m256d cosine{_mm256_blendv_pd(c, s, swap)};
+    const __m256d sine_sign{_mm256_castsi256_pd(
+        _mm256_slli_epi64(_mm256_and_si256(k, two_bit), 62))};
+    const __m256d cosine_sign{_mm256_castsi256_pd(_mm256_slli_epi64(
+        _mm256_and_si256(_mm256_add_epi64(k, one_bit), two_bit), 62))};
+    _mm256_storeu_pd(sines + i, _mm256_xor_pd(sine, sine_sign));
+    _mm256_storeu_pd(cosines + i, _mm256_xor_pd(cosine, cosine_sign));
+  }
+  sinCosScalar(angles + i, count - i, sines + i, cosines + i);
+}
+
+#endif  // ISOMETRY_X86_KERNELS
+
+KernelTable selectKernels() {
+  const InstructionSet preferred[] = {
+      InstructionSet::kAvx512, InstructionSet::kAvx2, InstructionSet::kSse2};
+  for (const InstructionSet instruction_set : preferred) {
+    if (isSupported(instruction_set)) {
+      return kernelsFor(instruction_set);
+    }
+  }
+  return kernelsFor(InstructionSet::kScalar);
+}
+
+}  // namespace
+
+bool isSupported(const InstructionSet instruction_set) {
+#ifdef ISOMETRY_X86_KERNELS
+  __builtin_cpu_init();
+  switch (instruction_set) {
+    case InstructionSet::kScalar:
+      return true;
+    case InstructionSet::kSse2:
+      return __builtin_cpu_supports("sse2");
+    case InstructionSet::kAvx2:
+      return __builtin_cpu_supports("avx2");
+    case InstructionSet::kAvx512:
+      return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+#else
+  return instruction_set == InstructionSet::kScalar;
+#endif
+}
+
+KernelTable kernelsFor(const InstructionSet instruction_set) {
+  if (!isSupported(instruction_set)) {
+    throw std::invalid_argument("Instruction set not supported");
+  }
+  switch (instruction_set) {
+#ifdef ISOMETRY_X86_KERNELS
+    case InstructionSet::kSse2:
+      return KernelTable{instruction_set, matrixProductSse2,
+                         matrixVectorProductSse2, alignedMatrixProductSse2,
+                         alignedMatrixVectorProductSse2, sinCosSse2};
+    case InstructionSet::kAvx2:
+      return KernelTable{instruction_set, matrixProductAvx2,
+                         matrixVectorProductAvx2, alignedMatrixProductAvx2,
+                         alignedMatrixVectorProductAvx2, sinCosAvx2};
+    // There's no gain in spreading a three element product over eight lanes,
+    // so the matrix-vector product reuses the AVX2 kernel. Padded rows are
+    // exactly one AVX2 register, so the aligned kernels do too. Four lanes of
+    // sines and cosines already cost about as much as assembling the
+    // rotations from them, so that kernel is reused as well.
+    case InstructionSet::kAvx512:
+      return KernelTable{instruction_set, matrixProductAvx512,
+                         matrixVectorProductAvx2, alignedMatrixProductAvx2,
+                         alignedMatrixVectorProductAvx2, sinCosAvx2};
+#endif
+    default:
+      return KernelTable{InstructionSet::kScalar, matrixProductScalar,
+                         matrixVectorProductScalar,
+                         alignedMatrixProductScalar,
+                         alignedMatrixVectorProductScalar, sinCosScalar};
+  }
+}
+
+const KernelTable &activeKernels() {
+  static const KernelTable kernels{selectKernels()};
+  return kernels;
+}
+
+}  // namespace kernels
+}  // namespace math
+}  // namespace ekumen
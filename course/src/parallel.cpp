@@ -0,0 +1,55 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/parallel.hpp>
+
+namespace ekumen {
+namespace math {
+
+void composeBatch(const Isometry &lhs, std::span<Isometry> isometries,
+                  ThreadPool &pool) {
+  // |lhs| may be one of the elements other workers are updating.
+  const Isometry lhs_copy{lhs};
+  pool.parallelFor(isometries.size(),
+                   [&](const std::size_t begin, const std::size_t end) {
+                     for (std::size_t i = begin; i < end; ++i) {
+                       isometries[i] = lhs_copy * isometries[i];
+                     }
+                   });
+}
+
+void composeBatch(std::span<Isometry> isometries, const Isometry &rhs,
+                  ThreadPool &pool) {
+  const Isometry rhs_copy{rhs};
+  pool.parallelFor(isometries.size(),
+                   [&](const std::size_t begin, const std::size_t end) {
+                     for (std::size_t i = begin; i < end; ++i) {
+                       isometries[i] *= rhs_copy;
+                     }
+                   });
+}
+
+void inverseBatch(std::span<Isometry> isometries, ThreadPool &pool) {
+  pool.parallelFor(isometries.size(),
+                   [&](const std::size_t begin, const std::size_t end) {
+                     for (std::size_t i = begin; i < end; ++i) {
+                       isometries[i] = isometries[i].inverse();
+                     }
+                   });
+}
+
+void transformBatch(const Isometry &isometry, std::span<Vector3> points,
+                    ThreadPool &pool) {
+  pool.parallelFor(points.size(),
+                   [&](const std::size_t begin, const std::size_t end) {
+                     for (std::size_t i = begin; i < end; ++i) {
+                       points[i] = isometry * points[i];
+                     }
+                   });
+}
+
+}  // namespace math
+}  // namespace ekumen
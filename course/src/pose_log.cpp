@@ -0,0 +1,295 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/pose_log.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <bit>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <isometry/serialization.hpp>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+// Records are used in place, so their in-memory layout must be the file one.
+// That only holds on little-endian hosts, where the file is also written
+// without any conversion; elsewhere readers and writers throw when opened.
+constexpr bool kLittleEndian{std::endian::native == std::endian::little};
+
+void checkEndianness() {
+  if (!kLittleEndian) {
+    throw std::runtime_error(
+        "Pose logs are only supported on little-endian hosts");
+  }
+}
+
+static_assert(std::is_trivially_copyable<Vector3>::value &&
+                  std::is_trivially_copyable<Isometry>::value,
+              "Records are used in place");
+static_assert(sizeof(Vector3) == serialization::kVector3Size,
+              "Vector3 is padded");
+static_assert(sizeof(Isometry) == serialization::kIsometrySize,
+              "Isometry is padded");
+static_assert(serialization::kHeaderSize % alignof(Isometry) == 0,
+              "Records would be misaligned");
+
+template <typename T>
+constexpr serialization::RecordType kRecordType{};
+template <>
+constexpr serialization::RecordType kRecordType<Vector3>{
+    serialization::RecordType::kVector3};
+template <>
+constexpr serialization::RecordType kRecordType<Isometry>{
+    serialization::RecordType::kIsometry};
+
+[[noreturn]] void throwSystemError(const std::string &what,
+                                   const std::string &path) {
+  throw std::system_error(errno, std::generic_category(),
+                          what + " " + path);
+}
+
+// RAII file descriptor, closed unless released.
+class FileDescriptor {
+ public:
+  explicit FileDescriptor(const int fd) : fd_{fd} {}
+  ~FileDescriptor() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+  FileDescriptor(const FileDescriptor &) = delete;
+  FileDescriptor &operator=(const FileDescriptor &) = delete;
+
+  int get() const { return fd_; }
+  int release() { return std::exchange(fd_, -1); }
+
+ private:
+  int fd_;
+};
+
+// Writes all of |size| bytes at |offset|, or at the current position if
+// |offset| is negative.
+void writeAll(const int fd, const void *data, std::size_t size, off_t offset,
+              const std::string &path) {
+  const char *bytes{static_cast<const char *>(data)};
+  while (size > 0) {
+    const ssize_t written{offset < 0 ? ::write(fd, bytes, size)
+                                     : ::pwrite(fd, bytes, size, offset)};
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwSystemError("Can't write to", path);
+    }
+    bytes += written;
+    size -= static_cast<std::size_t>(written);
+    if (offset >= 0) {
+      offset += written;
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+PoseLogReader<T>::PoseLogReader(const std::string &path) {
+  checkEndianness();
+  const FileDescriptor fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (fd.get() < 0) {
+    throwSystemError("Can't open", path);
+  }
+  struct stat status;
+  if (::fstat(fd.get(), &status) != 0) {
+    throwSystemError("Can't stat", path);
+  }
+  const std::size_t size{static_cast<std::size_t>(status.st_size)};
+  if (size < serialization::kHeaderSize) {
+    throw std::invalid_argument("Truncated pose log " + path);
+  }
+  void *mapping{::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd.get(), 0)};
+  if (mapping == MAP_FAILED) {
+    throwSystemError("Can't map", path);
+  }
+  mapping_ = mapping;
+  mapping_size_ = size;
+
+  const std::uint8_t *bytes{static_cast<const std::uint8_t *>(mapping)};
+  std::uint64_t count{0};
+  try {
+    count = serialization::decodeHeader(std::span{bytes, size},
+                                        kRecordType<T>);
+  } catch (...) {
+    unmap();
+    throw;
+  }
+  // Records past the header count, e.g. those of a writer that died before
+  // flushing them, are ignored.
+  if (count > (size - serialization::kHeaderSize) / sizeof(T)) {
+    unmap();
+    throw std::invalid_argument("Truncated pose log " + path);
+  }
+  records_ = std::span<const T>{
+      reinterpret_cast<const T *>(bytes + serialization::kHeaderSize),
+      static_cast<std::size_t>(count)};
+}
+
+template <typename T>
+PoseLogReader<T>::~PoseLogReader() {
+  unmap();
+}
+
+template <typename T>
+PoseLogReader<T>::PoseLogReader(PoseLogReader &&other) noexcept
+    : mapping_{std::exchange(other.mapping_, nullptr)},
+      mapping_size_{std::exchange(other.mapping_size_, 0)},
+      records_{std::exchange(other.records_, {})} {}
+
+template <typename T>
+PoseLogReader<T> &PoseLogReader<T>::operator=(PoseLogReader &&other) noexcept {
+  if (this != &other) {
+    unmap();
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapping_size_ = std::exchange(other.mapping_size_, 0);
+    records_ = std::exchange(other.records_, {});
+  }
+  return *this;
+}
+
+template <typename T>
+void PoseLogReader<T>::unmap() {
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    records_ = {};
+  }
+}
+
+template <typename T>
+PoseLogWriter<T>::PoseLogWriter(const std::string &path,
+                                const std::size_t buffer_size)
+    : path_{path}, buffer_size_{buffer_size} {
+  checkEndianness();
+  if (buffer_size == 0) {
+    throw std::invalid_argument("The buffer size can't be zero");
+  }
+  FileDescriptor fd{
+      ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+  if (fd.get() < 0) {
+    throwSystemError("Can't create", path);
+  }
+  std::uint8_t header[serialization::kHeaderSize];
+  serialization::encodeHeader(kRecordType<T>, 0, header);
+  writeAll(fd.get(), header, sizeof(header), -1, path_);
+  buffer_.reserve(buffer_size);
+  fd_ = fd.release();
+}
+
+template <typename T>
+PoseLogWriter<T>::~PoseLogWriter() {
+  try {
+    close();
+  } catch (...) {
+  }
+}
+
+template <typename T>
+void PoseLogWriter<T>::append(const T &record) {
+  if (fd_ < 0) {
+    throw std::logic_error("Appending to closed pose log " + path_);
+  }
+  buffer_.push_back(record);
+  // The buffer outgrows its size if writing it failed.
+  if (buffer_.size() >= buffer_size_) {
+    writeBuffer();
+  }
+}
+
+template <typename T>
+void PoseLogWriter<T>::append(std::span<const T> records) {
+  if (fd_ < 0) {
+    throw std::logic_error("Appending to closed pose log " + path_);
+  }
+  // Large blocks skip the buffer.
+  if (records.size() >= buffer_size_) {
+    writeBuffer();
+    writeRecords(records.data(), records.size());
+    return;
+  }
+  for (const T &record : records) {
+    append(record);
+  }
+}
+
+template <typename T>
+void PoseLogWriter<T>::flush() {
+  if (fd_ < 0) {
+    return;
+  }
+  writeBuffer();
+  std::uint8_t header[serialization::kHeaderSize];
+  serialization::encodeHeader(kRecordType<T>, written_, header);
+  writeAll(fd_, header, sizeof(header), 0, path_);
+}
+
+template <typename T>
+void PoseLogWriter<T>::close() {
+  if (fd_ < 0) {
+    return;
+  }
+  flush();
+  const int fd{std::exchange(fd_, -1)};
+  if (::close(fd) != 0) {
+    throwSystemError("Can't close", path_);
+  }
+}
+
+template <typename T>
+void PoseLogWriter<T>::writeBuffer() {
+  if (buffer_.empty()) {
+    return;
+  }
+  writeRecords(buffer_.data(), buffer_.size());
+  buffer_.clear();
+}
+
+template <typename T>
+void PoseLogWriter<T>::writeRecords(const T *records,
+                                    const std::size_t count) {
+  try {
+    writeAll(fd_, records, count * sizeof(T), -1, path_);
+  } catch (const std::system_error &) {
+    // Drops the partial record the failed write may have left, so that the
+    // file keeps ending at a record boundary.
+    const off_t end{static_cast<off_t>(serialization::kHeaderSize +
+                                       written_ * sizeof(T))};
+    if ((::ftruncate(fd_, end) != 0) ||
+        (::lseek(fd_, end, SEEK_SET) != end)) {
+      ::close(std::exchange(fd_, -1));
+    }
+    throw;
+  }
+  written_ += count;
+}
+
+template class PoseLogReader<Vector3>;
+template class PoseLogReader<Isometry>;
+template class PoseLogWriter<Vector3>;
+template class PoseLogWriter<Isometry>;
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,146 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+// Number of significant digits used when serializing to text.
+const int kStreamPrecision{9};
+
+// Angle between quaternions below which slerp() interpolates linearly.
+const double kSlerpMinAngle{1e-6};
+
+}  // namespace
+
+Quaternion Quaternion::fromAxisAngle(const Vector3 &axis, const double angle) {
+  const double axis_norm{axis.norm()};
+  if (axis_norm == 0.) {
+    throw std::invalid_argument("The rotation axis can't be a null vector");
+  }
+  const Vector3 k{std::sin(angle / 2.) / axis_norm * axis};
+  return Quaternion{std::cos(angle / 2.), k.x(), k.y(), k.z()};
+}
+
+Quaternion Quaternion::fromRotationMatrix(const Matrix3 &rotation) {
+  const double *r{rotation.data()};
+  const double r00{r[0]}, r01{r[1]}, r02{r[2]};
+  const double r10{r[3]}, r11{r[4]}, r12{r[5]};
+  const double r20{r[6]}, r21{r[7]}, r22{r[8]};
+  // Shepperd's method: extract the largest component first, so the square
+  // root and the divisions stay well conditioned.
+  const double trace{r00 + r11 + r22};
+  if (trace > std::max({r00, r11, r22})) {
+    const double s{2. * std::sqrt(1. + trace)};
+    return Quaternion{s / 4., (r21 - r12) / s, (r02 - r20) / s,
+                      (r10 - r01) / s};
+  }
+  if ((r00 >= r11) && (r00 >= r22)) {
+    const double s{2. * std::sqrt(1. + r00 - r11 - r22)};
+    return Quaternion{(r21 - r12) / s, s / 4., (r01 + r10) / s,
+                      (r02 + r20) / s};
+  }
+  if (r11 >= r22) {
+    const double s{2. * std::sqrt(1. - r00 + r11 - r22)};
+    return Quaternion{(r02 - r20) / s, (r01 + r10) / s, s / 4.,
+                      (r12 + r21) / s};
+  }
+  const double s{2. * std::sqrt(1. - r00 - r11 + r22)};
+  return Quaternion{(r10 - r01) / s, (r02 + r20) / s, (r12 + r21) / s,
+                    s / 4.};
+}
+
+double Quaternion::norm() const { return std::sqrt(dot(*this)); }
+
+Quaternion &Quaternion::normalize() {
+  const double quaternion_norm{norm()};
+  if (quaternion_norm == 0.) {
+    throw std::domain_error("Null quaternions can't be normalized");
+  }
+  const double scale{1. / quaternion_norm};
+  w_ *= scale;
+  x_ *= scale;
+  y_ *= scale;
+  z_ *= scale;
+  return *this;
+}
+
+Quaternion Quaternion::normalized() const {
+  Quaternion result{*this};
+  return result.normalize();
+}
+
+Quaternion slerp(const Quaternion &from, const Quaternion &to, const double t) {
+  // q and -q are the same rotation, flipping |to| takes the shortest arc.
+  const Quaternion target{from.dot(to) < 0. ? -to : to};
+  const double w[4]{from.w(), from.x(), from.y(), from.z()};
+  const double v[4]{target.w(), target.x(), target.y(), target.z()};
+  // The angle between the quaternions out of |from - to| and |from + to|,
+  // which unlike acos(dot) keeps its precision for close quaternions.
+  double difference{0.};
+  double sum{0.};
+  for (int i = 0; i < 4; ++i) {
+    difference += (v[i] - w[i]) * (v[i] - w[i]);
+    sum += (v[i] + w[i]) * (v[i] + w[i]);
+  }
+  const double theta{2. * std::atan2(std::sqrt(difference), std::sqrt(sum))};
+  double from_weight{1. - t};
+  double to_weight{t};
+  // Linear interpolation is exact to O(theta^2) for nearly equal rotations,
+  // where the sine ratios would divide by almost zero.
+  if (theta > kSlerpMinAngle) {
+    const double inverse_sin_theta{1. / std::sin(theta)};
+    from_weight = std::sin((1. - t) * theta) * inverse_sin_theta;
+    to_weight = std::sin(t * theta) * inverse_sin_theta;
+  }
+  Quaternion result{from_weight * w[0] + to_weight * v[0],
+                    from_weight * w[1] + to_weight * v[1],
+                    from_weight * w[2] + to_weight * v[2],
+                    from_weight * w[3] + to_weight * v[3]};
+  return result.normalize();
+}
+
+std::ostream &operator<<(std::ostream &os, const Quaternion &q) {
+  const std::streamsize precision{os.precision(kStreamPrecision)};
+  os << "(w: " << q.w() << ", x: " << q.x() << ", y: " << q.y()
+     << ", z: " << q.z() << ")";
+  os.precision(precision);
+  return os;
+}
+
+QuaternionIsometry QuaternionIsometry::rotateAround(const Vector3 &axis,
+                                                    const double angle) {
+  return QuaternionIsometry{Vector3::kZero,
+                            Quaternion::fromAxisAngle(axis, angle)};
+}
+
+QuaternionIsometry QuaternionIsometry::fromEulerAngles(const double roll,
+                                                       const double pitch,
+                                                       const double yaw) {
+  // Same convention as Isometry::fromEulerAngles.
+  return rotateAround(Vector3::kUnitX, roll) *
+         rotateAround(Vector3::kUnitY, pitch) *
+         rotateAround(Vector3::kUnitZ, yaw);
+}
+
+QuaternionIsometry &QuaternionIsometry::normalize() {
+  rotation_.normalize();
+  return *this;
+}
+
+std::ostream &operator<<(std::ostream &os, const QuaternionIsometry &t) {
+  return os << "[T: " << t.translation() << ", Q:" << t.quaternion() << "]";
+}
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,253 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/serialization.hpp>
+
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <isometry/quaternion.hpp>
+
+namespace ekumen {
+namespace math {
+namespace serialization {
+
+namespace {
+
+// Full precision records of an array are copied in one go, which needs the
+// types to be plain sequences of doubles.
+static_assert(sizeof(Vector3) == kVector3Size, "Vector3 is padded");
+static_assert(sizeof(Matrix3) == kMatrix3Size, "Matrix3 is padded");
+static_assert(sizeof(Isometry) == kIsometrySize, "Isometry is padded");
+static_assert(std::numeric_limits<double>::is_iec559,
+              "Doubles must be IEEE-754 binary64");
+
+const std::uint8_t kMagic[4]{'I', 'S', 'O', 'B'};
+
+constexpr bool kLittleEndianHost{std::endian::native == std::endian::little};
+
+void writeUint64(const std::uint64_t value, std::uint8_t *out) {
+  for (int i = 0; i < 8; ++i) {
+    out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+  }
+}
+
+std::uint64_t readUint64(const std::uint8_t *in) {
+  std::uint64_t value{0};
+  for (int i = 0; i < 8; ++i) {
+    value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+  }
+  return value;
+}
+
+void writeDoubles(const double *values, const std::size_t count,
+                  std::uint8_t *out) {
+  if constexpr (kLittleEndianHost) {
+    std::memcpy(out, values, count * sizeof(double));
+  } else {
+    for (std::size_t i = 0; i < count; ++i) {
+      writeUint64(std::bit_cast<std::uint64_t>(values[i]),
+                  out + i * sizeof(double));
+    }
+  }
+}
+
+void readDoubles(const std::uint8_t *in, const std::size_t count,
+                 double *values) {
+  if constexpr (kLittleEndianHost) {
+    std::memcpy(values, in, count * sizeof(double));
+  } else {
+    for (std::size_t i = 0; i < count; ++i) {
+      values[i] = std::bit_cast<double>(readUint64(in + i * sizeof(double)));
+    }
+  }
+}
+
+// Appends the header of an array of |count| records of type |type| and
+// reserves room for the records, returning where they start.
+std::uint8_t *appendHeader(const RecordType type, const std::size_t count,
+                           const std::size_t record_size,
+                           std::vector<std::uint8_t> &out) {
+  const std::size_t offset{out.size()};
+  out.resize(offset + kHeaderSize + count * record_size);
+  std::uint8_t *header{out.data() + offset};
+  encodeHeader(type, count, header);
+  return header + kHeaderSize;
+}
+
+// Validates the header of |in| and returns the number of records.
+std::size_t readHeader(std::span<const std::uint8_t> in,
+                       const RecordType type, const std::size_t record_size) {
+  const std::uint64_t count{decodeHeader(in, type)};
+  const std::size_t payload_size{in.size() - kHeaderSize};
+  if ((count > payload_size / record_size) ||
+      (count * record_size != payload_size)) {
+    throw std::invalid_argument("Array size does not match its header");
+  }
+  return static_cast<std::size_t>(count);
+}
+
+template <typename T>
+void encodeArray(const RecordType type, std::span<const T> values,
+                 std::vector<std::uint8_t> &out) {
+  std::uint8_t *records{appendHeader(type, values.size(), sizeof(T), out)};
+  writeDoubles(reinterpret_cast<const double *>(values.data()),
+               values.size() * sizeof(T) / sizeof(double), records);
+}
+
+template <typename T>
+std::vector<T> decodeArray(const RecordType type,
+                           std::span<const std::uint8_t> in) {
+  const std::size_t count{readHeader(in, type, sizeof(T))};
+  std::vector<T> values(count);
+  readDoubles(in.data() + kHeaderSize, count * sizeof(T) / sizeof(double),
+              reinterpret_cast<double *>(values.data()));
+  return values;
+}
+
+}  // namespace
+
+std::size_t encode(const Vector3 &value, std::uint8_t *out) {
+  writeDoubles(value.data(), 3, out);
+  return kVector3Size;
+}
+
+std::size_t encode(const Matrix3 &value, std::uint8_t *out) {
+  writeDoubles(value.data(), 9, out);
+  return kMatrix3Size;
+}
+
+std::size_t encode(const Isometry &value, std::uint8_t *out) {
+  encode(value.translation(), out);
+  encode(value.rotation(), out + kVector3Size);
+  return kIsometrySize;
+}
+
+std::size_t encodeCompact(const Isometry &value, std::uint8_t *out) {
+  const Quaternion q{Quaternion::fromRotationMatrix(value.rotation())};
+  const double rotation[4]{q.w(), q.x(), q.y(), q.z()};
+  encode(value.translation(), out);
+  writeDoubles(rotation, 4, out + kVector3Size);
+  return kCompactIsometrySize;
+}
+
+Vector3 decodeVector3(const std::uint8_t *in) {
+  Vector3 value;
+  readDoubles(in, 3, value.data());
+  return value;
+}
+
+Matrix3 decodeMatrix3(const std::uint8_t *in) {
+  Matrix3 value;
+  readDoubles(in, 9, value.data());
+  return value;
+}
+
+Isometry decodeIsometry(const std::uint8_t *in) {
+  return Isometry{decodeVector3(in), decodeMatrix3(in + kVector3Size)};
+}
+
+Isometry decodeCompactIsometry(const std::uint8_t *in) {
+  double rotation[4];
+  readDoubles(in + kVector3Size, 4, rotation);
+  Quaternion q{rotation[0], rotation[1], rotation[2], rotation[3]};
+  // Checked here, as normalizing would throw std::domain_error or silently
+  // give NaN.
+  const double norm{q.norm()};
+  if (norm == 0.) {
+    throw std::invalid_argument("Null rotation in compact isometry");
+  }
+  if (!std::isfinite(norm)) {
+    throw std::invalid_argument("Non-finite rotation in compact isometry");
+  }
+  q.normalize();
+  return Isometry{decodeVector3(in), q.toRotationMatrix()};
+}
+
+void encode(std::span<const Vector3> values, std::vector<std::uint8_t> &out) {
+  encodeArray(RecordType::kVector3, values, out);
+}
+
+void encode(std::span<const Matrix3> values, std::vector<std::uint8_t> &out) {
+  encodeArray(RecordType::kMatrix3, values, out);
+}
+
+void encode(std::span<const Isometry> values, std::vector<std::uint8_t> &out) {
+  encodeArray(RecordType::kIsometry, values, out);
+}
+
+void encodeCompact(std::span<const Isometry> values,
+                   std::vector<std::uint8_t> &out) {
+  std::uint8_t *records{appendHeader(RecordType::kCompactIsometry,
+                                     values.size(), kCompactIsometrySize,
+                                     out)};
+  for (const Isometry &value : values) {
+    records += encodeCompact(value, records);
+  }
+}
+
+std::vector<Vector3> decodeVector3s(std::span<const std::uint8_t> in) {
+  return decodeArray<Vector3>(RecordType::kVector3, in);
+}
+
+std::vector<Matrix3> decodeMatrix3s(std::span<const std::uint8_t> in) {
+  return decodeArray<Matrix3>(RecordType::kMatrix3, in);
+}
+
+std::vector<Isometry> decodeIsometries(std::span<const std::uint8_t> in) {
+  return decodeArray<Isometry>(RecordType::kIsometry, in);
+}
+
+std::vector<Isometry> decodeCompactIsometries(
+    std::span<const std::uint8_t> in) {
+  const std::size_t count{
+      readHeader(in, RecordType::kCompactIsometry, kCompactIsometrySize)};
+  std::vector<Isometry> values;
+  values.reserve(count);
+  const std::uint8_t *records{in.data() + kHeaderSize};
+  for (std::size_t i = 0; i < count; ++i) {
+    values.push_back(decodeCompactIsometry(records));
+    records += kCompactIsometrySize;
+  }
+  return values;
+}
+
+void encodeHeader(const RecordType type, const std::uint64_t count,
+                  std::uint8_t *out) {
+  std::memcpy(out, kMagic, sizeof(kMagic));
+  out[4] = kFormatVersion;
+  out[5] = static_cast<std::uint8_t>(type);
+  out[6] = 0;
+  out[7] = 0;
+  writeUint64(count, out + 8);
+}
+
+std::uint64_t decodeHeader(std::span<const std::uint8_t> in,
+                           const RecordType type) {
+  if (in.size() < kHeaderSize) {
+    throw std::invalid_argument("Truncated array header");
+  }
+  if (std::memcmp(in.data(), kMagic, sizeof(kMagic)) != 0) {
+    throw std::invalid_argument("Not an isometry library array");
+  }
+  if ((in[4] == 0) || (in[4] > kFormatVersion)) {
+    throw std::invalid_argument("Unsupported format version: " +
+                                std::to_string(in[4]));
+  }
+  if (in[5] != static_cast<std::uint8_t>(type)) {
+    throw std::invalid_argument("Unexpected record type: " +
+                                std::to_string(in[5]));
+  }
+  return readUint64(in.data() + 8);
+}
+
+}  // namespace serialization
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,236 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/text.hpp>
+
+#include <cstring>
+#include <string_view>
+#include <system_error>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+// Appends text to a caller buffer, remembering whether it ran out of space.
+class Writer {
+ public:
+  Writer(char *first, char *last) : ptr_{first}, last_{last} {}
+
+  void literal(const std::string_view text) {
+    if (!ok_ || static_cast<std::size_t>(last_ - ptr_) < text.size()) {
+      ok_ = false;
+      return;
+    }
+    std::memcpy(ptr_, text.data(), text.size());
+    ptr_ += text.size();
+  }
+
+  void number(const double value) {
+    if (!ok_) {
+      return;
+    }
+    const std::to_chars_result result{std::to_chars(ptr_, last_, value)};
+    if (result.ec != std::errc{}) {
+      ok_ = false;
+      return;
+    }
+    ptr_ = result.ptr;
+  }
+
+  void vector(const Vector3 &v) {
+    literal("(x: ");
+    number(v.x());
+    literal(", y: ");
+    number(v.y());
+    literal(", z: ");
+    number(v.z());
+    literal(")");
+  }
+
+  void matrix(const Matrix3 &m) {
+    literal("[");
+    for (int i = 0; i < 3; ++i) {
+      literal(i > 0 ? ", [" : "[");
+      number(m.atUnchecked(i, 0));
+      literal(", ");
+      number(m.atUnchecked(i, 1));
+      literal(", ");
+      number(m.atUnchecked(i, 2));
+      literal("]");
+    }
+    literal("]");
+  }
+
+  std::to_chars_result result() const {
+    if (!ok_) {
+      return {last_, std::errc::value_too_large};
+    }
+    return {ptr_, std::errc{}};
+  }
+
+ private:
+  char *ptr_;
+  char *last_;
+  bool ok_{true};
+};
+
+bool isSpace(const char c) {
+  return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+}
+
+// Consumes text from a caller buffer, remembering the first error.
+class Reader {
+ public:
+  Reader(const char *first, const char *last)
+      : first_{first}, ptr_{first}, last_{last} {}
+
+  // Matches |text|, where a space stands for any amount of whitespace,
+  // including none.
+  void literal(const std::string_view text) {
+    for (const char c : text) {
+      if (ec_ != std::errc{}) {
+        return;
+      }
+      if (c == ' ') {
+        skipSpaces();
+      } else if ((ptr_ != last_) && (*ptr_ == c)) {
+        ++ptr_;
+      } else {
+        ec_ = std::errc::invalid_argument;
+      }
+    }
+  }
+
+  double number() {
+    double value{0.};
+    if (ec_ != std::errc{}) {
+      return value;
+    }
+    skipSpaces();
+    const std::from_chars_result result{std::from_chars(ptr_, last_, value)};
+    ec_ = result.ec;
+    if (ec_ == std::errc::result_out_of_range) {
+      error_ptr_ = result.ptr;
+    }
+    ptr_ = result.ptr;
+    return value;
+  }
+
+  Vector3 vector() {
+    Vector3 v;
+    literal(" ( x : ");
+    v.x() = number();
+    literal(" , y : ");
+    v.y() = number();
+    literal(" , z : ");
+    v.z() = number();
+    literal(" )");
+    return v;
+  }
+
+  Matrix3 matrix() {
+    Matrix3 m;
+    literal(" [");
+    for (int i = 0; i < 3; ++i) {
+      literal(i > 0 ? " , [" : " [");
+      m.atUnchecked(i, 0) = number();
+      literal(" ,");
+      m.atUnchecked(i, 1) = number();
+      literal(" ,");
+      m.atUnchecked(i, 2) = number();
+      literal(" ]");
+    }
+    literal(" ]");
+    return m;
+  }
+
+  bool ok() const { return ec_ == std::errc{}; }
+
+  std::from_chars_result result() const {
+    if (ec_ == std::errc::result_out_of_range) {
+      return {error_ptr_, ec_};
+    }
+    if (ec_ != std::errc{}) {
+      return {first_, ec_};
+    }
+    return {ptr_, ec_};
+  }
+
+ private:
+  void skipSpaces() {
+    while ((ptr_ != last_) && isSpace(*ptr_)) {
+      ++ptr_;
+    }
+  }
+
+  const char *first_;
+  const char *ptr_;
+  const char *last_;
+  const char *error_ptr_{nullptr};
+  std::errc ec_{};
+};
+
+}  // namespace
+
+std::to_chars_result toChars(char *first, char *last, const Vector3 &value) {
+  Writer writer{first, last};
+  writer.vector(value);
+  return writer.result();
+}
+
+std::to_chars_result toChars(char *first, char *last, const Matrix3 &value) {
+  Writer writer{first, last};
+  writer.matrix(value);
+  return writer.result();
+}
+
+std::to_chars_result toChars(char *first, char *last, const Isometry &value) {
+  Writer writer{first, last};
+  writer.literal("[T: ");
+  writer.vector(value.translation());
+  writer.literal(", R:");
+  writer.matrix(value.rotation());
+  writer.literal("]");
+  return writer.result();
+}
+
+std::from_chars_result fromChars(const char *first, const char *last,
+                                 Vector3 &value) {
+  Reader reader{first, last};
+  const Vector3 result{reader.vector()};
+  if (reader.ok()) {
+    value = result;
+  }
+  return reader.result();
+}
+
+std::from_chars_result fromChars(const char *first, const char *last,
+                                 Matrix3 &value) {
+  Reader reader{first, last};
+  const Matrix3 result{reader.matrix()};
+  if (reader.ok()) {
+    value = result;
+  }
+  return reader.result();
+}
+
+std::from_chars_result fromChars(const char *first, const char *last,
+                                 Isometry &value) {
+  Reader reader{first, last};
+  reader.literal(" [ T :");
+  const Vector3 translation{reader.vector()};
+  reader.literal(" , R :");
+  const Matrix3 rotation{reader.matrix()};
+  reader.literal(" ]");
+  if (reader.ok()) {
+    value = Isometry{translation, rotation};
+  }
+  return reader.result();
+}
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,195 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/thread_pool.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+// Pool whose loop the current thread is running, if any. Loops started from
+// within a loop run serially instead of waiting on the pool they are in.
+thread_local const ThreadPool *current_pool{nullptr};
+
+constexpr std::uint64_t kLowHalf{0xFFFFFFFFu};
+
+std::uint64_t pack(const std::uint64_t begin, const std::uint64_t end) {
+  return (begin << 32) | end;
+}
+
+// Takes the first chunk of |share|.
+std::optional<std::uint64_t> takeFront(std::atomic<std::uint64_t> &share) {
+  std::uint64_t chunks{share.load(std::memory_order_relaxed)};
+  while (true) {
+    const std::uint64_t begin{chunks >> 32};
+    const std::uint64_t end{chunks & kLowHalf};
+    if (begin >= end) {
+      return std::nullopt;
+    }
+    if (share.compare_exchange_weak(chunks, pack(begin + 1, end),
+                                    std::memory_order_relaxed)) {
+      return begin;
+    }
+  }
+}
+
+// Takes the last chunk of |share|.
+std::optional<std::uint64_t> takeBack(std::atomic<std::uint64_t> &share) {
+  std::uint64_t chunks{share.load(std::memory_order_relaxed)};
+  while (true) {
+    const std::uint64_t begin{chunks >> 32};
+    const std::uint64_t end{chunks & kLowHalf};
+    if (begin >= end) {
+      return std::nullopt;
+    }
+    if (share.compare_exchange_weak(chunks, pack(begin, end - 1),
+                                    std::memory_order_relaxed)) {
+      return end - 1;
+    }
+  }
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(const std::size_t threads)
+    : ThreadPool(threads, Options{}) {}
+
+ThreadPool::ThreadPool(const std::size_t threads, const Options &options)
+    : options_{options} {
+  if (threads == 0) {
+    throw std::invalid_argument("A thread pool needs at least one thread");
+  }
+  if (options.chunk_size == 0) {
+    throw std::invalid_argument("The chunk size can't be zero");
+  }
+  shares_ = std::make_unique<Share[]>(threads);
+  workers_.reserve(threads - 1);
+  for (std::size_t i = 1; i < threads; ++i) {
+    workers_.emplace_back([this, i] { workerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+ThreadPool &ThreadPool::global() {
+  static ThreadPool pool{std::max(1u, std::thread::hardware_concurrency())};
+  return pool;
+}
+
+void ThreadPool::run(const std::size_t count, Task task, void *context) {
+  if (count == 0) {
+    return;
+  }
+  if (workers_.empty() || (count < options_.serial_threshold) ||
+      (current_pool != nullptr)) {
+    task(context, 0, count);
+    return;
+  }
+
+  const std::lock_guard<std::mutex> run_lock{run_mutex_};
+  // Chunk indices must fit in half a word.
+  const std::size_t max_chunks{std::numeric_limits<std::uint32_t>::max()};
+  const std::size_t chunk_size{
+      std::max(options_.chunk_size, count / max_chunks + 1)};
+  const std::uint64_t chunks{(count + chunk_size - 1) / chunk_size};
+  const std::size_t threads{size()};
+  for (std::size_t i = 0; i < threads; ++i) {
+    shares_[i].chunks.store(
+        pack(chunks * i / threads, chunks * (i + 1) / threads),
+        std::memory_order_relaxed);
+  }
+  task_ = task;
+  context_ = context;
+  count_ = count;
+  chunk_size_ = chunk_size;
+  error_ = nullptr;
+  {
+    // Publishes the loop to the workers.
+    const std::lock_guard<std::mutex> lock{mutex_};
+    ++generation_;
+    running_ = workers_.size();
+  }
+  wake_.notify_all();
+
+  current_pool = this;
+  work(0);
+  current_pool = nullptr;
+
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    done_.wait(lock, [this] { return running_ == 0; });
+  }
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void ThreadPool::workerLoop(const std::size_t index) {
+  current_pool = this;
+  std::uint64_t generation{0};
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      wake_.wait(lock, [&] { return stop_ || (generation_ != generation); });
+      if (stop_) {
+        return;
+      }
+      generation = generation_;
+    }
+    work(index);
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      if (--running_ == 0) {
+        done_.notify_one();
+      }
+    }
+  }
+}
+
+void ThreadPool::work(const std::size_t index) {
+  const std::size_t threads{size()};
+  while (const std::optional<std::uint64_t> chunk{
+             takeFront(shares_[index].chunks)}) {
+    runChunk(*chunk);
+  }
+  for (std::size_t i = 1; i < threads; ++i) {
+    Share &victim{shares_[(index + i) % threads]};
+    while (const std::optional<std::uint64_t> chunk{takeBack(victim.chunks)}) {
+      runChunk(*chunk);
+    }
+  }
+}
+
+void ThreadPool::runChunk(const std::uint64_t chunk) {
+  const std::size_t begin{static_cast<std::size_t>(chunk) * chunk_size_};
+  const std::size_t end{std::min(begin + chunk_size_, count_)};
+  try {
+    task_(context_, begin, end);
+  } catch (...) {
+    const std::lock_guard<std::mutex> lock{error_mutex_};
+    if (!error_) {
+      error_ = std::current_exception();
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace ekumen
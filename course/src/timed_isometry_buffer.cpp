@@ -0,0 +1,115 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/timed_isometry_buffer.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace ekumen {
+namespace math {
+
+TimedIsometryBuffer::TimedIsometryBuffer(const std::size_t capacity,
+                                         std::pmr::memory_resource *resource)
+    : entries_(capacity, resource) {
+  if (capacity == 0) {
+    throw std::invalid_argument("The buffer capacity can't be zero");
+  }
+}
+
+void TimedIsometryBuffer::insert(const double time, const Isometry &isometry) {
+  insert(time, QuaternionIsometry{isometry});
+}
+
+void TimedIsometryBuffer::insert(const double time,
+                                 const QuaternionIsometry &isometry) {
+  // A NaN would compare neither before nor after the other timestamps, and
+  // break the ordering lookups rely on.
+  if (!std::isfinite(time)) {
+    throw std::invalid_argument("Non-finite timestamp: " +
+                                std::to_string(time));
+  }
+  if (!empty()) {
+    const double newest_time{newestTime()};
+    if (time < newest_time) {
+      throw std::invalid_argument("Out of order timestamp: " +
+                                  std::to_string(time));
+    }
+    if (time == newest_time) {
+      entries_[(first_ + size_ - 1) % capacity()].isometry = isometry;
+      return;
+    }
+  }
+  if (size_ < capacity()) {
+    entries_[(first_ + size_) % capacity()] = Entry{time, isometry};
+    ++size_;
+  } else {
+    entries_[first_] = Entry{time, isometry};
+    first_ = (first_ + 1) % capacity();
+  }
+}
+
+Isometry TimedIsometryBuffer::lookup(const double time) const {
+  return lookupQuaternion(time).toIsometry();
+}
+
+QuaternionIsometry TimedIsometryBuffer::lookupQuaternion(
+    const double time) const {
+  if (empty() || !((time >= oldestTime()) && (time <= newestTime()))) {
+    throw std::out_of_range("No isometry available at time " +
+                            std::to_string(time));
+  }
+  // First entry not older than |time|.
+  std::size_t low{0};
+  std::size_t high{size_ - 1};
+  while (low < high) {
+    const std::size_t middle{low + (high - low) / 2};
+    if (at(middle).time < time) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  const Entry &after{at(low)};
+  if ((after.time == time) || (low == 0)) {
+    return after.isometry;
+  }
+  const Entry &before{at(low - 1)};
+  const double t{(time - before.time) / (after.time - before.time)};
+  const Vector3 &from{before.isometry.translation()};
+  const Vector3 &to{after.isometry.translation()};
+  return QuaternionIsometry{from + t * (to - from),
+                            slerp(before.isometry.quaternion(),
+                                  after.isometry.quaternion(), t)};
+}
+
+double TimedIsometryBuffer::oldestTime() const {
+  if (empty()) {
+    throw std::out_of_range("The buffer is empty");
+  }
+  return at(0).time;
+}
+
+double TimedIsometryBuffer::newestTime() const {
+  if (empty()) {
+    throw std::out_of_range("The buffer is empty");
+  }
+  return at(size_ - 1).time;
+}
+
+void TimedIsometryBuffer::clear() {
+  first_ = 0;
+  size_ = 0;
+}
+
+const TimedIsometryBuffer::Entry &TimedIsometryBuffer::at(
+    const std::size_t index) const {
+  return entries_[(first_ + index) % capacity()];
+}
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,74 @@
+/*
+ * Isometry library
+ * Author: Agustin Alba Chicar, 2019
+ * Author: Gerardo Puga, 2020
+ */
+
+#include <isometry/transform_chain.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace ekumen {
+namespace math {
+
+namespace {
+
+// isometry * point, inlined rather than going through the dispatched
+// matrix-vector kernel, whose call overhead dominates for single points.
+Vector3 apply(const Isometry &isometry, const Vector3 &point) {
+  const Matrix3 &r{isometry.rotation()};
+  const Vector3 &t{isometry.translation()};
+  return Vector3(r.get<0>().dot(point) + t.x(), r.get<1>().dot(point) + t.y(),
+                 r.get<2>().dot(point) + t.z());
+}
+
+}  // namespace
+
+void TransformChain::throwLengthError() {
+  throw std::length_error("Transform chains are limited to " +
+                          std::to_string(kMaxLength) + " isometries");
+}
+
+Isometry TransformChain::compose() const {
+  if (empty()) {
+    return Isometry::fromTranslation(Vector3::kZero);
+  }
+  Isometry result{*operands_[0]};
+  for (std::size_t i = 1; i < size_; ++i) {
+    result *= *operands_[i];
+  }
+  return result;
+}
+
+Vector3 TransformChain::transform(const Vector3 &point) const {
+  Vector3 result{point};
+  for (std::size_t i = size_; i > 0; --i) {
+    result = apply(*operands_[i - 1], result);
+  }
+  return result;
+}
+
+void TransformChain::transform(std::span<const Vector3> input,
+                               std::span<Vector3> output) const {
+  if (input.size() != output.size()) {
+    throw std::invalid_argument("Input and output sizes differ");
+  }
+  if ((input.size() < kBreakEvenPoints) || (size_ < 2)) {
+    for (std::size_t i = 0; i < input.size(); ++i) {
+      output[i] = transform(input[i]);
+    }
+    return;
+  }
+  const Isometry composed{compose()};
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    output[i] = apply(composed, input[i]);
+  }
+}
+
+void TransformChain::transform(std::span<Vector3> points) const {
+  transform(points, points);
+}
+
+}  // namespace math
+}  // namespace ekumen
@@ -0,0 +1,66 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the periodically re-orthonormalized AccumulatedIsometry.
+ */
+
+#include <limits>
+#include <stdexcept>
+
+#include <isometry/accumulated_isometry.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+GTEST_TEST(AccumulatedIsometryTest, KeepsTheRotationOrthonormal) {
+  const double kEpsilon{std::numeric_limits<double>::epsilon()};
+  const Isometry start{Isometry::fromEulerAngles(0.1, 0.2, 0.3)};
+  const Isometry delta{Vector3{1e-2, 0., 0.},
+                       Isometry::fromEulerAngles(1e-3, -2e-3, 3e-3)
+                           .rotation()};
+  Isometry plain{start};
+  AccumulatedIsometry accumulated{start};
+  for (int i = 0; i < 20000; ++i) {
+    plain *= delta;
+    accumulated *= delta;
+  }
+  EXPECT_FALSE(plain.isRigid());
+  EXPECT_TRUE(accumulated.isometry().isRigid());
+  // The drift in between corrections depends on the period only.
+  EXPECT_LE(accumulated.isometry().rotation().orthonormalityError(),
+            AccumulatedIsometry::kDefaultPeriod * kEpsilon);
+  EXPECT_NEAR((accumulated.isometry().translation() - plain.translation())
+                  .eval()
+                  .norm(),
+              0., 1e-9);
+}
+
+GTEST_TEST(AccumulatedIsometryTest, Period) {
+  const Isometry delta{Isometry::fromEulerAngles(1e-3, -2e-3, 3e-3)};
+  AccumulatedIsometry accumulated{Isometry::fromEulerAngles(0.1, 0.2, 0.3),
+                                  1};
+  EXPECT_EQ(accumulated.period(), 1);
+  for (int i = 0; i < 100; ++i) {
+    accumulated *= delta;
+    EXPECT_LE(accumulated.isometry().rotation().orthonormalityError(),
+              8. * std::numeric_limits<double>::epsilon());
+  }
+
+  EXPECT_TRUE(AccumulatedIsometry{}.isometry().isRigid());
+  EXPECT_THROW(AccumulatedIsometry(Isometry{}), std::domain_error);
+  EXPECT_THROW(AccumulatedIsometry(delta, 0), std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the padded AlignedVector3 and AlignedMatrix3 layout.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include <isometry/aligned.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+bool isAligned(const void *pointer) {
+  return reinterpret_cast<std::uintptr_t>(pointer) % 32 == 0;
+}
+
+GTEST_TEST(AlignedTest, Layout) {
+  const AlignedVector3 v{1., 2., 3.};
+  EXPECT_EQ(v.data()[3], 0.);
+  EXPECT_EQ(AlignedVector3{}.compact(), Vector3::kZero);
+
+  const Matrix3 m{1., 2., 3., 4., 5., 6., 7., 8., 9.};
+  const AlignedMatrix3 aligned{m};
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(aligned[i].compact(), m[i]);
+    EXPECT_EQ(aligned.data()[4 * i + 3], 0.);
+  }
+
+  std::vector<AlignedVector3> vectors(5);
+  std::vector<AlignedMatrix3> matrices(5);
+  for (std::size_t i = 0; i < vectors.size(); ++i) {
+    EXPECT_TRUE(isAligned(&vectors[i]));
+    EXPECT_TRUE(isAligned(&matrices[i]));
+  }
+}
+
+GTEST_TEST(AlignedTest, Conversions) {
+  const Vector3 v{1., -2., 3.5};
+  const AlignedVector3 aligned{v};
+  EXPECT_EQ(aligned.compact(), v);
+  EXPECT_EQ(aligned.x(), 1.);
+  EXPECT_EQ(aligned[2], 3.5);
+  EXPECT_EQ(aligned, AlignedVector3(1., -2., 3.5));
+  EXPECT_NE(aligned, AlignedVector3(1., -2., 3.));
+
+  const Matrix3 m{
+      Isometry::fromEulerAngles(0.3, -0.1, 0.7).rotation()};
+  EXPECT_EQ(AlignedMatrix3{m}.compact(), m);
+
+  std::stringstream packed, padded;
+  packed << m << v;
+  padded << AlignedMatrix3{m} << aligned;
+  EXPECT_EQ(packed.str(), padded.str());
+}
+
+GTEST_TEST(AlignedTest, ProductsMatchThePackedLayout) {
+  const Matrix3 m1{1., 2., 3., 4., 5., 6., 7., 8., 9.};
+  const Matrix3 m2{Isometry::fromEulerAngles(0.3, -0.1, 0.7).rotation()};
+  const Vector3 v{0.25, -1.5, 3.};
+
+  const AlignedMatrix3 product{AlignedMatrix3{m1}.product(AlignedMatrix3{m2})};
+  const Matrix3 expected_product{m1.product(m2)};
+  const Matrix3 compact_product{product.compact()};
+  EXPECT_EQ(std::memcmp(compact_product.data(), expected_product.data(),
+                        9 * sizeof(double)),
+            0);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(product.data()[4 * i + 3], 0.);
+  }
+
+  const AlignedVector3 transformed{AlignedMatrix3{m1} * AlignedVector3{v}};
+  const Vector3 expected_vector{m1 * v};
+  const Vector3 compact_vector{transformed.compact()};
+  EXPECT_EQ(std::memcmp(compact_vector.data(), expected_vector.data(),
+                        3 * sizeof(double)),
+            0);
+  EXPECT_EQ(transformed.data()[3], 0.);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the lock-free AtomicVector3 and AtomicIsometry snapshots. Build
+ * with -DISOMETRY_ENABLE_TSAN=ON to run them under ThreadSanitizer.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <isometry/atomic.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+// An isometry with all its twelve values set to |value|, so that torn reads
+// show up as mixed values.
+Isometry uniformIsometry(const double value) {
+  return Isometry{Vector3{value, value, value},
+                  Matrix3{value, value, value, value, value, value, value,
+                          value, value}};
+}
+
+// Whether all the twelve values of |isometry| are the same, returning it in
+// |value|.
+bool isUniform(const Isometry &isometry, double &value) {
+  value = isometry.translation().x();
+  const double *rotation{isometry.rotation().data()};
+  for (int i = 0; i < 3; ++i) {
+    if (isometry.translation().atUnchecked(i) != value) {
+      return false;
+    }
+  }
+  for (int i = 0; i < 9; ++i) {
+    if (rotation[i] != value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+GTEST_TEST(AtomicTest, SingleThreaded) {
+  AtomicVector3 vector;
+  EXPECT_EQ(vector.load(), Vector3::kZero);
+  vector.store(Vector3{1., 2., 3.});
+  EXPECT_EQ(vector.load(), Vector3(1., 2., 3.));
+
+  const Isometry t{Vector3{1., 2., 3.}, Matrix3::kIdentity};
+  AtomicIsometry isometry{t};
+  EXPECT_EQ(isometry.load(), t);
+  const std::uint64_t version{isometry.version()};
+  isometry.store(t.inverse());
+  EXPECT_EQ(isometry.version(), version + 1);
+
+  Isometry snapshot;
+  EXPECT_TRUE(isometry.tryLoad(snapshot));
+  EXPECT_EQ(snapshot, t.inverse());
+}
+
+GTEST_TEST(AtomicTest, ReadersNeverSeeTornSnapshots) {
+  const int kStores{200000};
+  const int kReaders{4};
+  AtomicIsometry published{uniformIsometry(0.)};
+  std::atomic<bool> done{false};
+  std::atomic<int> torn_reads{0};
+  std::atomic<int> stale_reads{0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < kReaders; ++i) {
+    readers.emplace_back([&]() {
+      double last{0.};
+      while (!done.load(std::memory_order_acquire)) {
+        double value{};
+        if (!isUniform(published.load(), value)) {
+          ++torn_reads;
+        } else if (value < last) {
+          ++stale_reads;
+        } else {
+          last = value;
+        }
+      }
+    });
+  }
+
+  std::thread writer([&]() {
+    for (int i = 1; i <= kStores; ++i) {
+      published.store(uniformIsometry(i));
+    }
+    done.store(true, std::memory_order_release);
+  });
+
+  writer.join();
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(torn_reads.load(), 0);
+  EXPECT_EQ(stale_reads.load(), 0);
+  double value{};
+  EXPECT_TRUE(isUniform(published.load(), value));
+  EXPECT_EQ(value, kStores);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,85 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the compile-time evaluation of vectors, matrices and isometries.
+ */
+
+#include <isometry/isometry.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+constexpr Vector3 kP{1., 2., 3.};
+constexpr Vector3 kQ{4., 5., 6.};
+constexpr Matrix3 kM{1., 2., 3., 4., 5., 6., 7., 8., 10.};
+constexpr Matrix3 kRotZ{0., -1., 0., 1., 0., 0., 0., 0., 1.};
+constexpr Isometry kT{Vector3{1., 2., 3.}, kRotZ};
+
+static_assert(kP.x() == 1. && kP[1] == 2. && kP.z() == 3., "Vector3 access");
+static_assert(kP + kQ == Vector3(5., 7., 9.), "Vector3 sum");
+static_assert(2. * kP - kQ / 2. == Vector3(0., 1.5, 3.), "Vector3 expression");
+static_assert(kP.dot(kQ) == 32., "Vector3 dot product");
+static_assert(Vector3::kUnitX.cross(Vector3::kUnitY) == Vector3::kUnitZ,
+              "Vector3 cross product");
+static_assert(Vector3{1., 2., 3.} == Vector3({1., 2., 3.}),
+              "Vector3 initializer list");
+
+static_assert(kM[2][2] == 10. && kM.element(1, 0) == 4., "Matrix3 access");
+static_assert(kM.col(1) == Vector3(2., 5., 8.), "Matrix3 column");
+static_assert(kM.det() == -3., "Matrix3 determinant");
+static_assert(kM.transpose().row(0) == Vector3(1., 4., 7.),
+              "Matrix3 transpose");
+static_assert(kM.product(Matrix3::kIdentity) == kM, "Matrix3 product");
+static_assert(kM.product(kM.inverse()) == Matrix3::kIdentity,
+              "Matrix3 inverse");
+static_assert(kM * kP == Vector3(14., 32., 53.), "Matrix3-Vector3 product");
+static_assert(kM - kM == Matrix3::kZero, "Matrix3 expression");
+
+static_assert(kT * Vector3(1., 1., 1.) == Vector3(0., 3., 4.),
+              "Isometry transform");
+static_assert(kT * kT.inverse() == Isometry::fromTranslation(Vector3::kZero),
+              "Isometry inverse");
+static_assert((kT * kT).rotation() == kRotZ.product(kRotZ),
+              "Isometry composition");
+static_assert(Isometry::fromTranslation(kP).translation() == kP,
+              "Isometry from translation");
+
+GTEST_TEST(ConstexprTest, CompileTimeResultsMatchRunTimeResults) {
+  const Matrix3 m{kM};
+  const Vector3 p{kP};
+  constexpr Matrix3 kSquare{kM.product(kM)};
+  constexpr Vector3 kImage{kM * kP};
+  EXPECT_EQ(m.product(m), kSquare);
+  EXPECT_EQ(m * p, kImage);
+  // Both paths evaluate the same sums in the same order, so results are
+  // bit-identical rather than merely close.
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ((m * p)[i], kImage[i]);
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_EQ(m.product(m)[i][j], kSquare[i][j]);
+    }
+  }
+}
+
+GTEST_TEST(ConstexprTest, CheckedAccessStillThrowsAtRunTime) {
+  const Vector3 p{kP};
+  const Matrix3 m{kM};
+  EXPECT_THROW(p[3], std::out_of_range);
+  EXPECT_THROW(m[-1], std::out_of_range);
+  EXPECT_THROW(Vector3({1., 2.}), std::invalid_argument);
+  EXPECT_THROW(Matrix3::kZero.inverse(), std::domain_error);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,96 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the lazily evaluated Vector3 and Matrix3 arithmetic expressions.
+ */
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include <isometry/isometry.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+GTEST_TEST(ExpressionTest, OperatorsReturnLazyExpressions) {
+  const Vector3 p{1., 2., 3.};
+  const Matrix3 m{1., 2., 3., 4., 5., 6., 7., 8., 9.};
+
+  static_assert(!std::is_same<decltype(p + p), Vector3>::value,
+                "Vector3 sums should be lazy");
+  static_assert(!std::is_same<decltype(2. * m + m), Matrix3>::value,
+                "Matrix3 sums should be lazy");
+  static_assert(std::is_same<decltype(m * p), Vector3>::value,
+                "Matrix-vector products are evaluated eagerly");
+}
+
+GTEST_TEST(ExpressionTest, ChainedVectorExpressions) {
+  const Vector3 p{1., 2., 3.};
+  const Vector3 q{4., 5., 6.};
+  const Vector3 r{7., 8., 9.};
+
+  const Vector3 result = 2. * p + q * r - r / 2. + (p - q) / q;
+  EXPECT_EQ(result, Vector3(2. + 28. - 3.5 - 0.75, 4. + 40. - 4. - 0.6,
+                            6. + 54. - 4.5 - 0.5));
+  EXPECT_EQ(p + q + r, Vector3(12., 15., 18.));
+  EXPECT_TRUE(p + q == q + p);
+  EXPECT_TRUE(p + q != q - p);
+
+  Vector3 accumulator{p};
+  accumulator += q * 2. - r;
+  EXPECT_EQ(accumulator, Vector3(2., 4., 6.));
+}
+
+GTEST_TEST(ExpressionTest, AssignmentIsAliasSafe) {
+  Vector3 v{1., 2., 3.};
+  const Vector3 w{1., 1., 1.};
+  v = w + v * 2.;
+  EXPECT_EQ(v, Vector3(3., 5., 7.));
+  v = v / v;
+  EXPECT_EQ(v, Vector3(1., 1., 1.));
+
+  Matrix3 m{1., 2., 3., 4., 5., 6., 7., 8., 9.};
+  m = m * m - m;
+  EXPECT_EQ(m, Matrix3({0., 2., 6., 12., 20., 30., 42., 56., 72.}));
+}
+
+GTEST_TEST(ExpressionTest, ChainedMatrixExpressions) {
+  const Matrix3 m1{1., 2., 3., 4., 5., 6., 7., 8., 9.};
+  const Matrix3 m2{9., 8., 7., 6., 5., 4., 3., 2., 1.};
+  const Matrix3 m3{Matrix3::kOnes};
+
+  const Matrix3 result = 2 * m2 + m3 - m1;
+  EXPECT_EQ(result, Matrix3({18., 15., 12., 9., 6., 3., 0., -3., -6.}));
+  EXPECT_EQ((m1 + m2) / 10., Matrix3::kOnes);
+
+  // Expressions convert to their value type when passed to functions, and
+  // eval() gives access to the value type members.
+  EXPECT_NEAR((m1 + m1).eval().det(), 0., 1e-12);
+  EXPECT_EQ((m1 - m1) * Vector3(1., 2., 3.), Vector3::kZero);
+}
+
+GTEST_TEST(ExpressionTest, ExpressionsCanBeStreamed) {
+  const Vector3 p{1., 2., 3.};
+  std::stringstream vector_stream;
+  vector_stream << p + p;
+  EXPECT_EQ(vector_stream.str(), "(x: 2, y: 4, z: 6)");
+
+  std::stringstream matrix_stream;
+  matrix_stream << 2. * Matrix3::kIdentity;
+  EXPECT_EQ(matrix_stream.str(), "[[2, 0, 0], [0, 2, 0], [0, 0, 2]]");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,169 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the FrameGraph transform tree.
+ */
+
+#include <cmath>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+
+#include <isometry/frame_graph.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+// map -> odom -> base -> arm -> sensor
+//                     -> camera
+struct RobotFrames {
+  RobotFrames()
+      : graph{"map"},
+        map_from_odom{Vector3{10., 0., 0.},
+                      Isometry::rotateAround(Vector3::kUnitZ, M_PI / 2.)
+                          .rotation()},
+        odom_from_base{Isometry::fromTranslation(Vector3{1., 2., 0.})},
+        base_from_arm{Vector3{0., 0., 1.},
+                      Isometry::rotateAround(Vector3::kUnitX, M_PI / 4.)
+                          .rotation()},
+        arm_from_sensor{Isometry::fromTranslation(Vector3{0., 0.5, 0.})},
+        base_from_camera{Isometry::fromTranslation(Vector3{0.2, 0., 0.3})} {
+    graph.addFrame("odom", "map", map_from_odom);
+    graph.addFrame("base", "odom", odom_from_base);
+    graph.addFrame("arm", "base", base_from_arm);
+    graph.addFrame("sensor", "arm", arm_from_sensor);
+    graph.addFrame("camera", "base", base_from_camera);
+  }
+
+  FrameGraph graph;
+  const Isometry map_from_odom;
+  const Isometry odom_from_base;
+  const Isometry base_from_arm;
+  const Isometry arm_from_sensor;
+  const Isometry base_from_camera;
+};
+
+GTEST_TEST(FrameGraphTest, Structure) {
+  RobotFrames robot;
+  EXPECT_EQ(robot.graph.size(), 6u);
+  EXPECT_EQ(robot.graph.id("map"), FrameGraph::kRootId);
+  EXPECT_EQ(robot.graph.name(robot.graph.id("sensor")), "sensor");
+  EXPECT_EQ(robot.graph.parent(robot.graph.id("camera")),
+            robot.graph.id("base"));
+  EXPECT_EQ(robot.graph.parentTransform(robot.graph.id("arm")),
+            robot.base_from_arm);
+  EXPECT_TRUE(robot.graph.contains("odom"));
+  EXPECT_FALSE(robot.graph.contains("gripper"));
+
+  EXPECT_THROW(robot.graph.id("gripper"), std::out_of_range);
+  EXPECT_THROW(robot.graph.name(100), std::out_of_range);
+  EXPECT_THROW(robot.graph.addFrame("arm", "base", robot.base_from_arm),
+               std::invalid_argument);
+  EXPECT_THROW(robot.graph.addFrame("gripper", 100, robot.base_from_arm),
+               std::out_of_range);
+  EXPECT_THROW(robot.graph.setTransform("map", robot.map_from_odom),
+               std::invalid_argument);
+}
+
+GTEST_TEST(FrameGraphTest, RootTransforms) {
+  RobotFrames robot;
+  EXPECT_EQ(robot.graph.rootTransform("map"),
+            Isometry::fromTranslation(Vector3::kZero));
+  EXPECT_EQ(robot.graph.rootTransform("odom"), robot.map_from_odom);
+  EXPECT_EQ(robot.graph.rootTransform("sensor"),
+            robot.map_from_odom * robot.odom_from_base * robot.base_from_arm *
+                robot.arm_from_sensor);
+  EXPECT_EQ(robot.graph.rootTransform("camera"),
+            robot.map_from_odom * robot.odom_from_base *
+                robot.base_from_camera);
+}
+
+GTEST_TEST(FrameGraphTest, RelativeTransforms) {
+  RobotFrames robot;
+  const Vector3 p{1., 2., 3.};
+  const Isometry camera_from_sensor{
+      robot.graph.relativeTransform("camera", "sensor")};
+  EXPECT_EQ(camera_from_sensor * p,
+            robot.base_from_camera.inverse() *
+                (robot.base_from_arm * (robot.arm_from_sensor * p)));
+  const Vector3 round_trip{robot.graph.relativeTransform("sensor", "camera") *
+                           (camera_from_sensor * p)};
+  EXPECT_NEAR((round_trip - p).eval().norm(), 0., 1e-12);
+  EXPECT_EQ(robot.graph.relativeTransform("map", "odom"), robot.map_from_odom);
+  EXPECT_EQ(robot.graph.relativeTransform("arm", "arm"),
+            Isometry::fromTranslation(Vector3::kZero));
+}
+
+GTEST_TEST(FrameGraphTest, UpdatesInvalidateTheSubtree) {
+  RobotFrames robot;
+  // Fills the cache before updating.
+  robot.graph.rootTransform("sensor");
+  robot.graph.rootTransform("camera");
+
+  const Isometry new_base_from_arm{
+      Isometry::fromTranslation(Vector3{0., 0., 2.})};
+  robot.graph.setTransform("arm", new_base_from_arm);
+  EXPECT_EQ(robot.graph.parentTransform(robot.graph.id("arm")),
+            new_base_from_arm);
+  EXPECT_EQ(robot.graph.rootTransform("sensor"),
+            robot.map_from_odom * robot.odom_from_base * new_base_from_arm *
+                robot.arm_from_sensor);
+  EXPECT_EQ(robot.graph.rootTransform("camera"),
+            robot.map_from_odom * robot.odom_from_base *
+                robot.base_from_camera);
+
+  // Updating an edge near the root reaches every frame under it.
+  const Isometry new_map_from_odom{
+      Isometry::fromTranslation(Vector3{-5., 0., 0.})};
+  robot.graph.setTransform("odom", new_map_from_odom);
+  EXPECT_EQ(robot.graph.rootTransform("camera"),
+            new_map_from_odom * robot.odom_from_base * robot.base_from_camera);
+  EXPECT_EQ(robot.graph.rootTransform("sensor"),
+            new_map_from_odom * robot.odom_from_base * new_base_from_arm *
+                robot.arm_from_sensor);
+}
+
+GTEST_TEST(FrameGraphTest, FramesAddedToCachedSubtrees) {
+  RobotFrames robot;
+  robot.graph.rootTransform("sensor");
+  const Isometry sensor_from_lens{
+      Isometry::fromTranslation(Vector3{0., 0., 0.1})};
+  const FrameGraph::FrameId lens{
+      robot.graph.addFrame("lens", robot.graph.id("sensor"), sensor_from_lens)};
+  EXPECT_EQ(robot.graph.rootTransform(lens),
+            robot.graph.rootTransform("sensor") * sensor_from_lens);
+}
+
+GTEST_TEST(FrameGraphTest, MemoryResources) {
+  // Names longer than the small string buffer, so that they allocate too.
+  alignas(8) unsigned char buffer[16384];
+  std::pmr::monotonic_buffer_resource arena{
+      buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+  FrameGraph graph{"the_map_frame_of_the_planner", &arena};
+  EXPECT_EQ(graph.resource(), &arena);
+  const Isometry step{Isometry::fromTranslation(Vector3{1., 0., 0.})};
+  std::string parent{"the_map_frame_of_the_planner"};
+  for (int i = 0; i < 10; ++i) {
+    const std::string name{"a_long_frame_name_number_" + std::to_string(i)};
+    graph.addFrame(name, parent, step);
+    parent = name;
+  }
+  EXPECT_EQ(graph.name(graph.id(parent)), parent);
+  EXPECT_EQ(graph.rootTransform(parent),
+            Isometry::fromTranslation(Vector3{10., 0., 0.}));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,141 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the operation counters. They hold in both instrumented and
+ * plain builds: the counters just stay at zero in the latter.
+ */
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <isometry/instrumentation.hpp>
+#include <isometry/isometry.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+using instrumentation::Operation;
+
+// Expected counter increment for |calls| calls.
+std::uint64_t expected(const std::uint64_t calls) {
+  return instrumentation::kEnabled ? calls : 0;
+}
+
+GTEST_TEST(InstrumentationTest, CountsCalls) {
+  const Isometry t1{Isometry::fromTranslation(Vector3{1., 2., 3.})};
+  const Isometry t2{Isometry::rotateAround(Vector3::kUnitZ, 0.5)};
+  const instrumentation::Snapshot before{instrumentation::snapshot()};
+
+  Isometry result{t1};
+  for (int i = 0; i < 100; ++i) {
+    result = result * t2;
+  }
+  const Isometry inverse{result.inverse()};
+  EXPECT_NEAR((result * inverse).translation().norm(), 0., 1e-12);
+  Matrix3::kIdentity.det();
+
+  const instrumentation::Snapshot after{instrumentation::snapshot()};
+  // The check of the inverse composes once more, and inverting a matrix
+  // takes its determinant.
+  EXPECT_EQ(after[Operation::kIsometryCompose].calls -
+                before[Operation::kIsometryCompose].calls,
+            expected(101));
+  EXPECT_EQ(after[Operation::kIsometryInverse].calls -
+                before[Operation::kIsometryInverse].calls,
+            expected(1));
+  EXPECT_EQ(after[Operation::kMatrix3Det].calls -
+                before[Operation::kMatrix3Det].calls,
+            expected(2));
+
+  // The first call of each thread is always sampled.
+  EXPECT_LE(after[Operation::kIsometryCompose].samples,
+            after[Operation::kIsometryCompose].calls);
+  EXPECT_EQ(after[Operation::kIsometryCompose].samples > 0,
+            instrumentation::kEnabled);
+}
+
+GTEST_TEST(InstrumentationTest, ConstantEvaluationIsNotCounted) {
+  const instrumentation::Snapshot before{instrumentation::snapshot()};
+  constexpr double kDet{Matrix3::kIdentity.det()};
+  EXPECT_EQ(kDet, 1.);
+  EXPECT_EQ(instrumentation::snapshot()[Operation::kMatrix3Det].calls,
+            before[Operation::kMatrix3Det].calls);
+}
+
+GTEST_TEST(InstrumentationTest, KeepsTheCountersOfExitedThreads) {
+  const instrumentation::Snapshot before{instrumentation::snapshot()};
+  std::thread worker{[] {
+    for (int i = 0; i < 10; ++i) {
+      Isometry::fromEulerAngles(0.1 * i, 0.2, 0.3).inverse();
+    }
+  }};
+  worker.join();
+  const instrumentation::Snapshot after{instrumentation::snapshot()};
+  EXPECT_EQ(after[Operation::kIsometryFromEulerAngles].calls -
+                before[Operation::kIsometryFromEulerAngles].calls,
+            expected(10));
+  EXPECT_EQ(after[Operation::kIsometryInverse].calls -
+                before[Operation::kIsometryInverse].calls,
+            expected(10));
+  EXPECT_EQ(after[Operation::kMatrix3Det].calls -
+                before[Operation::kMatrix3Det].calls,
+            expected(10));
+}
+
+GTEST_TEST(InstrumentationTest, LatencyQuantiles) {
+  instrumentation::OperationStats stats;
+  EXPECT_EQ(stats.latencyQuantile(0.5), 0u);
+  // Three samples in [4, 8) ns and one in [64, 128) ns.
+  stats.latency_histogram[2] = 3;
+  stats.latency_histogram[6] = 1;
+  stats.samples = 4;
+  EXPECT_EQ(stats.latencyQuantile(0.), 7u);
+  EXPECT_EQ(stats.latencyQuantile(0.5), 7u);
+  EXPECT_EQ(stats.latencyQuantile(0.75), 7u);
+  EXPECT_EQ(stats.latencyQuantile(0.99), 127u);
+  EXPECT_EQ(stats.latencyQuantile(1.), 127u);
+}
+
+GTEST_TEST(InstrumentationTest, Dump) {
+  instrumentation::Snapshot snapshot;
+  snapshot.operations[static_cast<int>(Operation::kIsometryInverse)].calls =
+      42;
+  // Two calls timed in [64, 128) ns.
+  instrumentation::OperationStats &det{
+      snapshot.operations[static_cast<int>(Operation::kMatrix3Det)]};
+  det.latency_histogram[6] = 2;
+  det.samples = 2;
+  det.latency_sum = 150;
+  std::stringstream os;
+  instrumentation::dump(snapshot, os);
+  const std::string text{os.str()};
+  EXPECT_NE(text.find("# TYPE isometry_inverse_calls_total counter\n"
+                      "isometry_inverse_calls_total 42\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("isometry_compose_latency_ns_bucket{le=\"1\"} 0\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("matrix3_det_latency_ns_bucket{le=\"+Inf\"} 2\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("isometry_from_euler_angles_latency_ns_sum 0\n"
+                      "isometry_from_euler_angles_latency_ns_count 0\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("matrix3_det_latency_ns_sum 150\n"
+                      "matrix3_det_latency_ns_count 2\n"),
+            std::string::npos);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
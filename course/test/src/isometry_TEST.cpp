@@ -9,9 +9,13 @@
  * needed to implement an isometry.
  */
 
+#include <array>
 #include <cmath>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <isometry/isometry.hpp>
 #include "gtest/gtest.h"
@@ -109,6 +113,228 @@ GTEST_TEST(IsometryTest, IsometryFullTests) {
   EXPECT_EQ(t9 * Vector3(1., 1., 1.), Vector3(3., 5., 7.));
 }
 
+GTEST_TEST(IsometryTest, RigidInverse) {
+  const double kTolerance{1e-12};
+  const Isometry t1{Isometry::fromTranslation(Vector3{1., -2., 3.}) *
+                    Isometry::fromEulerAngles(0.3, -1.2, 2.5)};
+  const Vector3 p{4., 5., -6.};
+
+  EXPECT_TRUE(t1.isRigid());
+  EXPECT_TRUE(Isometry::fromTranslation(Vector3::kUnitX).isRigid());
+  EXPECT_FALSE(Isometry().isRigid());
+  EXPECT_FALSE(Isometry(Vector3::kZero, 2. * Matrix3::kIdentity).isRigid());
+  // Reflections are orthonormal but not rotations.
+  EXPECT_FALSE(Isometry(Vector3::kZero,
+                        Matrix3{-1., 0., 0., 0., 1., 0., 0., 0., 1.})
+                   .isRigid());
+  const Matrix3 sheared{1., 1e-3, 0., 0., 1., 0., 0., 0., 1.};
+  EXPECT_TRUE(Matrix3::kIdentity.isRotation());
+  EXPECT_FALSE(sheared.isRotation());
+  EXPECT_TRUE(sheared.isRotation(1e-2));
+
+  EXPECT_TRUE(areAlmostEqual(t1.rigidInverse(), t1.inverse(), kTolerance));
+  EXPECT_TRUE(t1.rigidInverse().isRigid());
+  EXPECT_TRUE(areAlmostEqual(t1.rigidInverse() * t1,
+                             Isometry::fromTranslation(Vector3::kZero),
+                             kTolerance));
+  EXPECT_NEAR((t1.inverseTransform(p) - t1.inverse() * p).eval().norm(), 0.,
+              kTolerance);
+  EXPECT_NEAR((t1.inverseTransform(t1 * p) - p).eval().norm(), 0., kTolerance);
+  EXPECT_EQ(t1.rotation().transposeProduct(p), t1.rotation().transpose() * p);
+
+  constexpr Isometry kShift{Isometry::fromTranslation(Vector3{1., 2., 3.})};
+  static_assert(kShift.isRigid());
+  static_assert(kShift.rigidInverse() ==
+                Isometry::fromTranslation(Vector3{-1., -2., -3.}));
+  static_assert(kShift.inverseTransform(Vector3{1., 2., 3.}) == Vector3::kZero);
+}
+
+GTEST_TEST(IsometryTest, Orthonormalization) {
+  const double kEpsilon{std::numeric_limits<double>::epsilon()};
+  const Isometry delta{Isometry::fromEulerAngles(1e-3, -2e-3, 3e-3)};
+  Isometry drifted{Isometry::fromEulerAngles(0.1, 0.2, 0.3)};
+  for (int i = 0; i < 20000; ++i) {
+    drifted *= delta;
+  }
+  EXPECT_GT(drifted.rotation().orthonormalityError(), 1000. * kEpsilon);
+  EXPECT_FALSE(drifted.isRigid());
+
+  const Isometry corrected{drifted.orthonormalized()};
+  EXPECT_LE(corrected.rotation().orthonormalityError(), 8. * kEpsilon);
+  EXPECT_TRUE(corrected.isRigid());
+  EXPECT_EQ(corrected.translation(), drifted.translation());
+  // The correction is of the order of the drift.
+  EXPECT_TRUE(areAlmostEqual(corrected, drifted, 1e-10));
+
+  // Drift of any size the steps converge from.
+  const Matrix3 sheared{1.1, 0.1, 0., 0., 0.9, 0.05, 0.02, 0., 1.05};
+  EXPECT_GT(sheared.orthonormalityError(), 0.1);
+  EXPECT_TRUE(sheared.orthonormalized().isRotation());
+  EXPECT_EQ(Matrix3::kIdentity.orthonormalized(), Matrix3::kIdentity);
+  EXPECT_EQ(Matrix3::kIdentity.orthonormalityError(), 0.);
+
+  EXPECT_THROW((2. * Matrix3::kIdentity).eval().orthonormalized(),
+               std::domain_error);
+  EXPECT_THROW(Matrix3::kZero.orthonormalized(), std::domain_error);
+  const double nan{std::numeric_limits<double>::quiet_NaN()};
+  const Matrix3 invalid{nan, 0., 0., 0., 1., 0., 0., 0., 1.};
+  EXPECT_TRUE(std::isnan(invalid.orthonormalityError()));
+  EXPECT_THROW(invalid.orthonormalized(), std::domain_error);
+
+  static_assert(Matrix3::kIdentity.orthonormalized() == Matrix3::kIdentity);
+}
+
+// Checks fromEulerAngles() and toEulerAngles() of |Convention| against the
+// composition of elementary rotations about |axes|. |gimbal_lock| is a second
+// angle that lines up the first and third axes. The sample angles are in
+// the ranges toEulerAngles() returns for every convention.
+template <EulerConvention Convention>
+void checkEulerConvention(const Vector3 (&axes)[3], const bool extrinsic,
+                          const double gimbal_lock) {
+  const double kTolerance{1e-14};
+  const std::array<double, 3> samples[] = {
+      {0.3, 1.2, 2.5}, {-2.9, 0.4, 1.}, {1.5, 1.1, -0.1}};
+  for (const std::array<double, 3> &angles : samples) {
+    const Isometry first{Isometry::rotateAround(axes[0], angles[0])};
+    const Isometry second{Isometry::rotateAround(axes[1], angles[1])};
+    const Isometry third{Isometry::rotateAround(axes[2], angles[2])};
+    const Isometry built{Isometry::fromEulerAngles<Convention>(
+        angles[0], angles[1], angles[2])};
+    EXPECT_TRUE(areAlmostEqual(
+        built, extrinsic ? third * second * first : first * second * third,
+        kTolerance));
+    const std::array<double, 3> extracted{built.toEulerAngles<Convention>()};
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_NEAR(extracted[i], angles[i], kTolerance);
+    }
+  }
+
+  const Isometry locked{
+      Isometry::fromEulerAngles<Convention>(0.7, gimbal_lock, -0.2)};
+  const std::array<double, 3> extracted{locked.toEulerAngles<Convention>()};
+  EXPECT_NEAR(extracted[1], gimbal_lock, 1e-7);
+  EXPECT_TRUE(areAlmostEqual(
+      Isometry::fromEulerAngles<Convention>(extracted[0], extracted[1],
+                                            extracted[2]),
+      locked, kTolerance));
+}
+
+GTEST_TEST(IsometryTest, EulerConventions) {
+  const Vector3 kXYZ[3] = {Vector3::kUnitX, Vector3::kUnitY, Vector3::kUnitZ};
+  const Vector3 kZYX[3] = {Vector3::kUnitZ, Vector3::kUnitY, Vector3::kUnitX};
+  const Vector3 kZYZ[3] = {Vector3::kUnitZ, Vector3::kUnitY, Vector3::kUnitZ};
+  checkEulerConvention<EulerConvention::kIntrinsicXYZ>(kXYZ, false, M_PI / 2.);
+  checkEulerConvention<EulerConvention::kIntrinsicZYX>(kZYX, false, -M_PI / 2.);
+  checkEulerConvention<EulerConvention::kIntrinsicZYZ>(kZYZ, false, 0.);
+  checkEulerConvention<EulerConvention::kExtrinsicXYZ>(kXYZ, true, -M_PI / 2.);
+  checkEulerConvention<EulerConvention::kExtrinsicZYX>(kZYX, true, M_PI / 2.);
+  checkEulerConvention<EulerConvention::kExtrinsicZYZ>(kZYZ, true, M_PI);
+
+  const Isometry rpy{Isometry::fromEulerAngles(0.1, -0.7, 2.3)};
+  EXPECT_EQ(rpy,
+            Isometry::fromEulerAngles<EulerConvention::kIntrinsicXYZ>(
+                0.1, -0.7, 2.3));
+  const auto [roll, pitch, yaw] = rpy.toEulerAngles();
+  EXPECT_NEAR(roll, 0.1, 1e-15);
+  EXPECT_NEAR(pitch, -0.7, 1e-15);
+  EXPECT_NEAR(yaw, 2.3, 1e-15);
+}
+
+GTEST_TEST(IsometryTest, BatchConstructors) {
+  const double kTolerance{1e-15};
+  const Vector3 axis{1., -2., 0.5};
+  std::vector<double> roll, pitch, yaw;
+  // More than a chunk of angles, so that the last one is partial.
+  for (int i = 0; i < 300; ++i) {
+    roll.push_back(0.1 * i - 15.);
+    pitch.push_back(-0.07 * i + 3.);
+    yaw.push_back(0.013 * i * i);
+  }
+
+  std::vector<Isometry> isometries(roll.size());
+  Isometry::rotateAround(axis, roll, isometries);
+  for (std::size_t i = 0; i < roll.size(); ++i) {
+    EXPECT_TRUE(areAlmostEqual(isometries[i],
+                               Isometry::rotateAround(axis, roll[i]),
+                               kTolerance))
+        << roll[i];
+  }
+
+  Isometry::fromEulerAngles(roll, pitch, yaw, isometries);
+  for (std::size_t i = 0; i < roll.size(); ++i) {
+    EXPECT_TRUE(areAlmostEqual(
+        isometries[i], Isometry::fromEulerAngles(roll[i], pitch[i], yaw[i]),
+        kTolerance))
+        << i;
+  }
+
+  std::vector<Isometry> too_short(roll.size() - 1);
+  EXPECT_THROW(Isometry::rotateAround(axis, roll, too_short),
+               std::invalid_argument);
+  EXPECT_THROW(Isometry::rotateAround(Vector3::kZero, roll, isometries),
+               std::invalid_argument);
+  EXPECT_THROW(Isometry::fromEulerAngles(roll, pitch, yaw, too_short),
+               std::invalid_argument);
+  EXPECT_THROW(Isometry::fromEulerAngles(roll, std::span<const double>{}, yaw,
+                                         isometries),
+               std::invalid_argument);
+}
+
+GTEST_TEST(IsometryTest, ExponentialAndLogarithm) {
+  const double kTolerance{1e-13};
+  // Without rotation the twist is the translation.
+  const Twist translation{Vector3{1., 2., 3.}, Vector3::kZero};
+  EXPECT_EQ(Isometry::exp(translation),
+            Isometry::fromTranslation(Vector3{1., 2., 3.}));
+  EXPECT_EQ(Isometry::fromTranslation(Vector3{1., 2., 3.}).log(),
+            translation);
+
+  // A quarter turn around z while moving along x is an arc of radius 2 / pi.
+  const Twist arc{Vector3::kUnitX, M_PI / 2. * Vector3::kUnitZ};
+  EXPECT_TRUE(areAlmostEqual(
+      Isometry::exp(arc),
+      Isometry{Vector3{2. / M_PI, 2. / M_PI, 0.},
+               Isometry::rotateAround(Vector3::kUnitZ, M_PI / 2.).rotation()},
+      kTolerance));
+
+  // Holding a twist twice as long composes its exponential with itself.
+  for (const double angle : {1e-9, 1e-4, 0.01, 0.3, 1.5}) {
+    const Twist twist{Vector3{0.3, -1., 2.}, angle * Vector3{1., 2., -2.} / 3.};
+    const Twist doubled{2. * twist.linear, 2. * twist.angular};
+    EXPECT_TRUE(areAlmostEqual(Isometry::exp(doubled),
+                               Isometry::exp(twist) * Isometry::exp(twist),
+                               kTolerance))
+        << angle;
+  }
+
+  for (const double angle : {0., 1e-9, 1e-4, 0.01, 0.3, 1.5, 3., M_PI - 1e-9}) {
+    const Twist twist{Vector3{0.3, -1., 2.}, angle * Vector3{1., 2., -2.} / 3.};
+    const Twist logarithm{Isometry::exp(twist).log()};
+    EXPECT_LT((logarithm.linear - twist.linear).eval().norm(), kTolerance)
+        << angle;
+    EXPECT_LT((logarithm.angular - twist.angular).eval().norm(), kTolerance)
+        << angle;
+  }
+  const Isometry half_turn{Isometry::fromEulerAngles(M_PI, 0., 0.) *
+                           Isometry::fromTranslation(Vector3{1., 2., 3.})};
+  EXPECT_TRUE(
+      areAlmostEqual(Isometry::exp(half_turn.log()), half_turn, kTolerance));
+
+  const std::vector<Twist> twists{translation, arc};
+  std::vector<Isometry> isometries(2);
+  Isometry::exp(twists, isometries);
+  EXPECT_EQ(isometries[0], Isometry::exp(translation));
+  EXPECT_EQ(isometries[1], Isometry::exp(arc));
+  std::vector<Twist> logarithms(2);
+  Isometry::log(isometries, logarithms);
+  EXPECT_EQ(logarithms[0], isometries[0].log());
+  EXPECT_EQ(logarithms[1], isometries[1].log());
+  EXPECT_THROW(Isometry::exp(twists, std::span<Isometry>{isometries}.first(1)),
+               std::invalid_argument);
+  EXPECT_THROW(Isometry::log(isometries, std::span<Twist>{}),
+               std::invalid_argument);
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace math
@@ -0,0 +1,243 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Checks that every SIMD kernel supported by the host matches the scalar
+ * kernel bit by bit, and the accuracy of the sines and cosines.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <isometry/isometry.hpp>
+#include <isometry/kernels.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+using kernels::InstructionSet;
+using kernels::KernelTable;
+
+const InstructionSet kAllInstructionSets[] = {
+    InstructionSet::kScalar, InstructionSet::kSse2, InstructionSet::kAvx2,
+    InstructionSet::kAvx512};
+
+GTEST_TEST(KernelsTest, ScalarIsAlwaysSupported) {
+  EXPECT_TRUE(kernels::isSupported(InstructionSet::kScalar));
+  EXPECT_EQ(kernels::kernelsFor(InstructionSet::kScalar).instruction_set,
+            InstructionSet::kScalar);
+  EXPECT_TRUE(kernels::isSupported(kernels::activeKernels().instruction_set));
+}
+
+GTEST_TEST(KernelsTest, UnsupportedInstructionSetsThrow) {
+  for (const InstructionSet instruction_set : kAllInstructionSets) {
+    if (!kernels::isSupported(instruction_set)) {
+      EXPECT_THROW(kernels::kernelsFor(instruction_set),
+                   std::invalid_argument);
+    }
+  }
+}
+
+GTEST_TEST(KernelsTest, KernelsAreBitIdenticalToScalar) {
+  std::mt19937 generator{1234};
+  std::uniform_real_distribution<double> distribution{-1e3, 1e3};
+  const KernelTable scalar{kernels::kernelsFor(InstructionSet::kScalar)};
+
+  for (const InstructionSet instruction_set : kAllInstructionSets) {
+    if (!kernels::isSupported(instruction_set)) {
+      continue;
+    }
+    const KernelTable simd{kernels::kernelsFor(instruction_set)};
+    for (int trial = 0; trial < 1000; ++trial) {
+      double lhs[9], rhs[9];
+      for (int i = 0; i < 9; ++i) {
+        lhs[i] = distribution(generator);
+        rhs[i] = distribution(generator);
+      }
+
+      double expected[9], actual[9];
+      scalar.matrix_product(lhs, rhs, expected);
+      simd.matrix_product(lhs, rhs, actual);
+      EXPECT_EQ(std::memcmp(expected, actual, sizeof(expected)), 0);
+
+      double expected_vector[3], actual_vector[3];
+      scalar.matrix_vector_product(lhs, rhs, expected_vector);
+      simd.matrix_vector_product(lhs, rhs, actual_vector);
+      EXPECT_EQ(
+          std::memcmp(expected_vector, actual_vector, sizeof(expected_vector)),
+          0);
+
+      // Same operands in the padded layout.
+      alignas(32) double padded_lhs[12], padded_rhs[12];
+      for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+          padded_lhs[4 * i + j] = lhs[3 * i + j];
+          padded_rhs[4 * i + j] = rhs[3 * i + j];
+        }
+        padded_lhs[4 * i + 3] = 0.;
+        padded_rhs[4 * i + 3] = 0.;
+      }
+
+      alignas(32) double padded[12];
+      simd.aligned_matrix_product(padded_lhs, padded_rhs, padded);
+      for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(std::memcmp(expected + 3 * i, padded + 4 * i,
+                              3 * sizeof(double)),
+                  0);
+        EXPECT_EQ(padded[4 * i + 3], 0.);
+      }
+
+      alignas(32) double padded_vector[4];
+      simd.aligned_matrix_vector_product(padded_lhs, padded_rhs,
+                                         padded_vector);
+      EXPECT_EQ(std::memcmp(expected_vector, padded_vector,
+                            sizeof(expected_vector)),
+                0);
+      EXPECT_EQ(padded_vector[3], 0.);
+    }
+  }
+}
+
+// The padding of the aligned results is +0 whatever the operands, and the
+// other elements keep matching the scalar kernel bit by bit, signed zeros and
+// NaN included.
+GTEST_TEST(KernelsTest, AlignedKernelsKeepThePaddingZero) {
+  const double kInf{std::numeric_limits<double>::infinity()};
+  const KernelTable scalar{kernels::kernelsFor(InstructionSet::kScalar)};
+  // An infinite element, which turns products by zero into NaN, and a
+  // negative row times a null vector, whose products are all -0.
+  alignas(32) const double lhs[2][12] = {
+      {kInf, 1., 2., 0., 3., -4., 5., 0., 6., 7., -8., 0.},
+      {1., 2., 3., 0., -1., -1., -1., 0., 4., 5., 6., 0.}};
+  alignas(32) const double rhs[2][12] = {
+      {1., 0., -2., 0., 3., 4., 0., 0., -5., 6., 7., 0.},
+      {0., 1., 2., 0., 0., 3., 4., 0., 0., 5., 6., 0.}};
+  const double kZero{0.};
+
+  for (const InstructionSet instruction_set : kAllInstructionSets) {
+    if (!kernels::isSupported(instruction_set)) {
+      continue;
+    }
+    const KernelTable simd{kernels::kernelsFor(instruction_set)};
+    for (int operands = 0; operands < 2; ++operands) {
+      alignas(32) double expected[12], actual[12];
+      scalar.aligned_matrix_product(lhs[operands], rhs[operands], expected);
+      simd.aligned_matrix_product(lhs[operands], rhs[operands], actual);
+      EXPECT_EQ(std::memcmp(expected, actual, sizeof(expected)), 0);
+      for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(std::memcmp(actual + 4 * i + 3, &kZero, sizeof(kZero)), 0);
+      }
+
+      alignas(32) double expected_vector[4], actual_vector[4];
+      scalar.aligned_matrix_vector_product(lhs[operands], rhs[operands],
+                                           expected_vector);
+      simd.aligned_matrix_vector_product(lhs[operands], rhs[operands],
+                                         actual_vector);
+      EXPECT_EQ(std::memcmp(expected_vector, actual_vector,
+                            sizeof(expected_vector)),
+                0);
+      EXPECT_EQ(std::memcmp(actual_vector + 3, &kZero, sizeof(kZero)), 0);
+    }
+  }
+}
+
+// Error of |value| in units in the last place of |exact|.
+double ulps(const double value, const long double exact) {
+  const double rounded{static_cast<double>(exact)};
+  const double ulp{std::nextafter(std::abs(rounded), HUGE_VAL) -
+                   std::abs(rounded)};
+  return static_cast<double>(std::abs(value - exact)) / ulp;
+}
+
+GTEST_TEST(KernelsTest, SinCos) {
+  std::mt19937 generator{1234};
+  std::vector<double> angles;
+  for (const double range : {4., 1e3, kernels::kSinCosRange}) {
+    std::uniform_real_distribution<double> distribution{-range, range};
+    for (int i = 0; i < 10000; ++i) {
+      angles.push_back(distribution(generator));
+    }
+  }
+  // Multiples of pi / 2, where reduction cancels, and beyond the range.
+  for (int k = -1000; k <= 1000; ++k) {
+    angles.push_back(static_cast<double>(k * 1.57079632679489661923132169L));
+  }
+  angles.insert(angles.end(), {0., 1e-300, -1e-8, 2e6, -1e9, HUGE_VAL,
+                               std::numeric_limits<double>::quiet_NaN()});
+
+  const std::size_t n{angles.size()};
+  std::vector<double> expected_sines(n), expected_cosines(n);
+  kernels::kernelsFor(InstructionSet::kScalar)
+      .sincos(angles.data(), n, expected_sines.data(),
+              expected_cosines.data());
+  for (std::size_t i = 0; i < n; ++i) {
+    if (std::isfinite(angles[i])) {
+      const long double angle{angles[i]};
+      EXPECT_LE(ulps(expected_sines[i], std::sin(angle)),
+                kernels::kSinCosMaxUlp)
+          << angles[i];
+      EXPECT_LE(ulps(expected_cosines[i], std::cos(angle)),
+                kernels::kSinCosMaxUlp)
+          << angles[i];
+    } else {
+      EXPECT_TRUE(std::isnan(expected_sines[i]));
+      EXPECT_TRUE(std::isnan(expected_cosines[i]));
+    }
+  }
+
+  for (const InstructionSet instruction_set : kAllInstructionSets) {
+    if (!kernels::isSupported(instruction_set)) {
+      continue;
+    }
+    // Every length up to a few registers, to cover the remainders.
+    for (std::size_t count = 0; count <= 11; ++count) {
+      std::vector<double> sines(n), cosines(n);
+      const std::size_t begin{n - 11 - count};
+      kernels::kernelsFor(instruction_set)
+          .sincos(angles.data() + begin, count, sines.data(), cosines.data());
+      EXPECT_EQ(std::memcmp(sines.data(), expected_sines.data() + begin,
+                            count * sizeof(double)),
+                0);
+      EXPECT_EQ(std::memcmp(cosines.data(), expected_cosines.data() + begin,
+                            count * sizeof(double)),
+                0);
+    }
+    std::vector<double> sines(n), cosines(n);
+    kernels::kernelsFor(instruction_set)
+        .sincos(angles.data(), n, sines.data(), cosines.data());
+    EXPECT_EQ(std::memcmp(sines.data(), expected_sines.data(),
+                          n * sizeof(double)),
+              0);
+    EXPECT_EQ(std::memcmp(cosines.data(), expected_cosines.data(),
+                          n * sizeof(double)),
+              0);
+  }
+}
+
+GTEST_TEST(KernelsTest, MatrixProducts) {
+  const Matrix3 m1{1., 2., 3., 4., 5., 6., 7., 8., 9.};
+  const Matrix3 m2{9., 8., 7., 6., 5., 4., 3., 2., 1.};
+
+  EXPECT_EQ(m1.product(m2),
+            Matrix3({30., 24., 18., 84., 69., 54., 138., 114., 90.}));
+  EXPECT_EQ(m1.product(Matrix3::kIdentity), m1);
+  EXPECT_EQ(Matrix3::kIdentity.product(m1), m1);
+  EXPECT_EQ(m1 * Vector3(1., 2., 3.), Vector3(14., 32., 50.));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,198 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the Translation3, AxisRotation and PlanarIsometry types.
+ */
+
+#include <cmath>
+#include <type_traits>
+
+#include <isometry/lightweight_isometry.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+constexpr double kTolerance{1e-14};
+const Isometry kIdentity{Isometry::fromTranslation(Vector3::kZero)};
+
+testing::AssertionResult areAlmostEqual(const Isometry &obj1,
+                                        const Isometry &obj2,
+                                        const double tolerance) {
+  for (int i = 0; i < 3; ++i) {
+    if (std::abs(obj1.translation()[i] - obj2.translation()[i]) > tolerance) {
+      return testing::AssertionFailure()
+             << "The isometries are not almost equal";
+    }
+    for (int j = 0; j < 3; ++j) {
+      if (std::abs(obj1.rotation()[i][j] - obj2.rotation()[i][j]) >
+          tolerance) {
+        return testing::AssertionFailure()
+               << "The isometries are not almost equal";
+      }
+    }
+  }
+  return testing::AssertionSuccess();
+}
+
+GTEST_TEST(LightweightIsometryTest, Translation3) {
+  const Translation3 t1{Vector3{1., 2., 3.}};
+  const Translation3 t2{Vector3{-4., 5., 0.5}};
+  const Vector3 point{0.5, -1., 2.};
+
+  EXPECT_EQ(Translation3{}.translation(), Vector3::kZero);
+  EXPECT_EQ((t1 * t2).translation(), (Vector3{-3., 7., 3.5}));
+  EXPECT_EQ(t1 * point, (Vector3{1.5, 1., 5.}));
+  EXPECT_EQ(t1 * t1.inverse(), Translation3{});
+  EXPECT_EQ(t1.toIsometry(), Isometry::fromTranslation(Vector3{1., 2., 3.}));
+  Translation3 t3{t1};
+  t3 *= t2;
+  EXPECT_EQ(t3, t1 * t2);
+  EXPECT_NE(t3, t1);
+}
+
+GTEST_TEST(LightweightIsometryTest, AxisRotation) {
+  const Vector3 point{0.5, -1., 2.};
+  const AxisRotation<Axis::kX> rx{0.3};
+  const AxisRotation<Axis::kY> ry{-1.2};
+  const AxisRotation<Axis::kZ> rz{2.5};
+
+  EXPECT_TRUE(areAlmostEqual(
+      rx, Isometry::rotateAround(Vector3::kUnitX, 0.3), kTolerance));
+  EXPECT_TRUE(areAlmostEqual(
+      ry, Isometry::rotateAround(Vector3::kUnitY, -1.2), kTolerance));
+  EXPECT_TRUE(areAlmostEqual(
+      rz, Isometry::rotateAround(Vector3::kUnitZ, 2.5), kTolerance));
+  EXPECT_NEAR((rx * point - rx.toIsometry() * point).eval().norm(), 0.,
+              kTolerance);
+  EXPECT_NEAR((ry * point - ry.toIsometry() * point).eval().norm(), 0.,
+              kTolerance);
+
+  // Same axis rotations add their angles.
+  EXPECT_NEAR((rz * AxisRotation<Axis::kZ>{0.5}).angle(), 3., kTolerance);
+  EXPECT_NEAR((rz * rz.inverse()).angle(), 0., kTolerance);
+  EXPECT_NEAR(AxisRotation<Axis::kZ>{-3.}.angle(), -3., kTolerance);
+  EXPECT_EQ(AxisRotation<Axis::kY>{}.toIsometry(), kIdentity);
+  AxisRotation<Axis::kX> rx2{rx};
+  rx2 *= rx;
+  EXPECT_NEAR(rx2.angle(), 0.6, kTolerance);
+  // Equality tolerates rounding, as for vectors and matrices.
+  for (int i = -20; i <= 20; ++i) {
+    const double a{0.15 * i};
+    const double b{0.7 - 0.05 * i};
+    EXPECT_EQ(AxisRotation<Axis::kZ>{a} * AxisRotation<Axis::kZ>{b},
+              AxisRotation<Axis::kZ>{a + b});
+    EXPECT_EQ(PlanarIsometry(1., 2., a) * PlanarIsometry(0., 0., b),
+              PlanarIsometry(1., 2., a + b));
+  }
+  EXPECT_NE(rx, AxisRotation<Axis::kX>{0.3 + 1e-12});
+
+  // Other axes leave the structure.
+  const Isometry rxy{rx * ry};
+  EXPECT_TRUE(areAlmostEqual(rxy, rx.toIsometry() * ry.toIsometry(),
+                             kTolerance));
+  EXPECT_TRUE(areAlmostEqual(rz * rx, rz.toIsometry() * rx.toIsometry(),
+                             kTolerance));
+}
+
+GTEST_TEST(LightweightIsometryTest, PlanarIsometry) {
+  const PlanarIsometry p1{1., 2., 0.7};
+  const PlanarIsometry p2{Vector3{-3., 0.5, 1.}, AxisRotation<Axis::kZ>{-2.}};
+  const Vector3 point{0.5, -1., 2.};
+
+  EXPECT_EQ(p1.translation(), (Vector3{1., 2., 0.}));
+  EXPECT_NEAR(p1.rotation().angle(), 0.7, kTolerance);
+  EXPECT_TRUE(areAlmostEqual(
+      p1,
+      Isometry::fromTranslation(Vector3{1., 2., 0.}) *
+          Isometry::rotateAround(Vector3::kUnitZ, 0.7),
+      kTolerance));
+  EXPECT_TRUE(areAlmostEqual(p1 * p2, p1.toIsometry() * p2.toIsometry(),
+                             kTolerance));
+  EXPECT_TRUE(areAlmostEqual(p1 * p1.inverse(), kIdentity, kTolerance));
+  EXPECT_TRUE(areAlmostEqual(p2.inverse(), p2.toIsometry().rigidInverse(),
+                             kTolerance));
+  EXPECT_NEAR((p2 * point - p2.toIsometry() * point).eval().norm(), 0.,
+              kTolerance);
+  PlanarIsometry p3{p1};
+  p3 *= p2;
+  EXPECT_EQ(p3, p1 * p2);
+  EXPECT_EQ(PlanarIsometry{}.toIsometry(), kIdentity);
+}
+
+// Every mixed composition matches the composition of the widened operands,
+// and keeps the narrowest type that can hold it.
+GTEST_TEST(LightweightIsometryTest, MixedCompositions) {
+  const Translation3 t{Vector3{1., 2., 3.}};
+  const AxisRotation<Axis::kX> rx{0.3};
+  const AxisRotation<Axis::kZ> rz{2.5};
+  const PlanarIsometry p{Vector3{-3., 0.5, 1.}, AxisRotation<Axis::kZ>{-2.}};
+  const Isometry isometry{Vector3{0.1, -0.2, 0.3},
+                          Isometry::fromEulerAngles(0.4, -0.5, 0.6)
+                              .rotation()};
+
+  const auto check = [&](const auto &lhs, const auto &rhs) {
+    EXPECT_TRUE(areAlmostEqual(lhs * rhs,
+                               Isometry{lhs} * Isometry{rhs},
+                               kTolerance));
+  };
+  check(t, isometry);
+  check(isometry, t);
+  check(rx, isometry);
+  check(isometry, rx);
+  check(rz, isometry);
+  check(isometry, rz);
+  check(p, isometry);
+  check(isometry, p);
+  check(t, rz);
+  check(rz, t);
+  check(t, rx);
+  check(rx, t);
+  check(t, p);
+  check(p, t);
+  check(rz, p);
+  check(p, rz);
+  check(rx, p);
+  check(p, rx);
+
+  static_assert(std::is_same_v<decltype(t * rz), PlanarIsometry>);
+  static_assert(std::is_same_v<decltype(rz * t), PlanarIsometry>);
+  static_assert(std::is_same_v<decltype(t * p), PlanarIsometry>);
+  static_assert(std::is_same_v<decltype(p * rz), PlanarIsometry>);
+  static_assert(std::is_same_v<decltype(t * rx), Isometry>);
+  static_assert(std::is_same_v<decltype(rx * p), Isometry>);
+  static_assert(std::is_same_v<decltype(isometry * t), Isometry>);
+}
+
+GTEST_TEST(LightweightIsometryTest, ConstantEvaluation) {
+  constexpr Translation3 kT{Vector3{1., 2., 3.}};
+  constexpr auto kRz{AxisRotation<Axis::kZ>::fromCosSin(0., 1.)};
+  constexpr PlanarIsometry kP{kT * kRz};
+  static_assert(kP.transform(Vector3::kUnitX) == Vector3{1., 3., 3.});
+  static_assert((kP * kP.inverse()).translation() == Vector3::kZero);
+  EXPECT_EQ(kP.toIsometry().rotation(),
+            (Matrix3{0., -1., 0., 1., 0., 0., 0., 0., 1.}));
+}
+
+GTEST_TEST(LightweightIsometryTest, OtherScalarTypes) {
+  const PlanarIsometryf pf{1.f, 2.f, 0.7f};
+  const Translation3l tl{Vector3l{1.L, 2.L, 3.L}};
+  EXPECT_NEAR(pf.rotation().angle(), 0.7f, 1e-6f);
+  EXPECT_EQ((tl * tl).translation(), (Vector3l{2.L, 4.L, 6.L}));
+  EXPECT_NEAR((AxisRotationl<Axis::kY>{0.25L} * AxisRotationl<Axis::kY>{0.5L})
+                  .angle(),
+              0.75L, 1e-18L);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -9,6 +9,7 @@
  * needed to implement an isometry.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include <string>
@@ -128,6 +129,46 @@ GTEST_TEST(Matrix3Test, Matrix3FullTests) {
   EXPECT_EQ(m4_moved[2][2], 10);
 }
 
+GTEST_TEST(Matrix3Test, ExponentialAndLogarithm) {
+  const double kTolerance{1e-14};
+  const Vector3 v{1., -2., 3.};
+  const Vector3 u{0.5, 4., -1.};
+  EXPECT_EQ(Matrix3::hat(v) * u, v.cross(u));
+  EXPECT_EQ(Matrix3::hat(v).vee(), v);
+  static_assert(Matrix3::hat(Vector3::kUnitX).vee() == Vector3::kUnitX);
+
+  EXPECT_EQ(Matrix3::exp(Vector3::kZero), Matrix3::kIdentity);
+  EXPECT_EQ(Matrix3::kIdentity.log(), Vector3::kZero);
+
+  // From the Taylor series, through the closed forms, up to pi.
+  const Vector3 axis{Vector3{2., -1., 0.5} / Vector3{2., -1., 0.5}.norm()};
+  for (const double angle : {1e-9, 1e-5, 1e-3, 0.02, 0.5, 2., 3., 3.14159,
+                             M_PI - 1e-9, M_PI}) {
+    const Matrix3 rotation{Matrix3::exp(angle * axis)};
+    EXPECT_TRUE(rotation.isRotation());
+    const Matrix3 expected{Isometry::rotateAround(axis, angle).rotation()};
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        EXPECT_NEAR(rotation[i][j], expected[i][j], kTolerance) << angle;
+      }
+    }
+    const Vector3 expected_log{angle * axis};
+    const Vector3 logarithm{rotation.log()};
+    // At pi the opposite rotation vector is right too.
+    const double error{std::min(
+        (logarithm - expected_log).eval().norm(),
+        angle == M_PI ? (logarithm + expected_log).eval().norm() : 1.)};
+    EXPECT_LT(error, kTolerance) << angle;
+  }
+
+  // Single precision has a Taylor series of its own.
+  const Vector3f small{1e-3f, -2e-3f, 5e-4f};
+  const Vector3f small_logarithm{Matrix3f::exp(small).log()};
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_NEAR(small_logarithm[i], small[i], 1e-9f);
+  }
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace math
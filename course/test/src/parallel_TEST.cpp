@@ -0,0 +1,154 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the parallel batch compose, inverse and transform operations.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <isometry/parallel.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+std::vector<Isometry> particles(const std::size_t size) {
+  std::vector<Isometry> result;
+  for (std::size_t i = 0; i < size; ++i) {
+    const double k{static_cast<double>(i)};
+    result.push_back(
+        Isometry::fromTranslation(Vector3{k, -0.5 * k, 1.}) *
+        Isometry::fromEulerAngles(0.001 * k, -0.002 * k, 0.003 * k));
+  }
+  return result;
+}
+
+// Parallel results must be bit-identical to the serial loop.
+void expectSame(const std::vector<Isometry> &lhs,
+                const std::vector<Isometry> &rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    ASSERT_EQ(std::memcmp(&lhs[i], &rhs[i], sizeof(Isometry)), 0) << i;
+  }
+}
+
+struct Pools {
+  Pools() : serial{1}, parallel{4, parallelOptions()} {}
+
+  static ThreadPool::Options parallelOptions() {
+    ThreadPool::Options options;
+    options.chunk_size = 100;
+    options.serial_threshold = 1000;
+    return options;
+  }
+
+  ThreadPool serial;
+  ThreadPool parallel;
+};
+
+const Isometry kMotion{Isometry::fromTranslation(Vector3{0.1, 0.2, 0.}) *
+                       Isometry::rotateAround(Vector3::kUnitZ, 0.05)};
+
+GTEST_TEST(ParallelTest, Compose) {
+  Pools pools;
+  for (const std::size_t size : {0, 10, 999, 1000, 5003}) {
+    std::vector<Isometry> expected{particles(size)};
+    for (Isometry &particle : expected) {
+      particle = kMotion * particle;
+    }
+    std::vector<Isometry> serial{particles(size)};
+    composeBatch(kMotion, serial, pools.serial);
+    expectSame(serial, expected);
+    std::vector<Isometry> parallel{particles(size)};
+    composeBatch(kMotion, parallel, pools.parallel);
+    expectSame(parallel, expected);
+
+    for (Isometry &particle : expected) {
+      particle *= kMotion;
+    }
+    composeBatch(parallel, kMotion, pools.parallel);
+    expectSame(parallel, expected);
+  }
+}
+
+// The composed isometry may be part of the array, e.g. to express every
+// pose relative to the first one; its value at the call is used throughout.
+GTEST_TEST(ParallelTest, ComposeWithAnElementOfTheArray) {
+  Pools pools;
+  const std::vector<Isometry> original{particles(5003)};
+  for (const std::size_t index : {std::size_t{0}, std::size_t{4000}}) {
+    std::vector<Isometry> expected{original};
+    for (Isometry &particle : expected) {
+      particle = original[index] * particle;
+    }
+    std::vector<Isometry> parallel{original};
+    composeBatch(parallel[index], parallel, pools.parallel);
+    expectSame(parallel, expected);
+
+    expected = original;
+    for (Isometry &particle : expected) {
+      particle *= original[index];
+    }
+    parallel = original;
+    composeBatch(parallel, parallel[index], pools.parallel);
+    expectSame(parallel, expected);
+  }
+}
+
+GTEST_TEST(ParallelTest, Inverse) {
+  Pools pools;
+  std::vector<Isometry> expected{particles(4321)};
+  for (Isometry &particle : expected) {
+    particle = particle.inverse();
+  }
+  std::vector<Isometry> parallel{particles(4321)};
+  inverseBatch(parallel, pools.parallel);
+  expectSame(parallel, expected);
+
+  // Default constructed isometries have a null rotation.
+  std::vector<Isometry> singular{particles(2000)};
+  singular[1500] = Isometry{};
+  EXPECT_THROW(inverseBatch(singular, pools.parallel), std::domain_error);
+}
+
+GTEST_TEST(ParallelTest, Transform) {
+  Pools pools;
+  std::vector<Vector3> points;
+  for (int i = 0; i < 3000; ++i) {
+    points.emplace_back(i, 2. * i, -i);
+  }
+  std::vector<Vector3> expected{points};
+  for (Vector3 &point : expected) {
+    point = kMotion * point;
+  }
+  transformBatch(kMotion, points, pools.parallel);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ASSERT_EQ(std::memcmp(&points[i], &expected[i], sizeof(Vector3)), 0);
+  }
+}
+
+GTEST_TEST(ParallelTest, GlobalPool) {
+  std::vector<Isometry> expected{particles(20000)};
+  for (Isometry &particle : expected) {
+    particle = kMotion * particle;
+  }
+  std::vector<Isometry> parallel{particles(20000)};
+  composeBatch(kMotion, parallel);
+  expectSame(parallel, expected);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
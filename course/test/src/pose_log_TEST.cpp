@@ -0,0 +1,182 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the memory-mapped pose log reader and its writer.
+ */
+
+#include <sys/resource.h>
+
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <isometry/pose_log.hpp>
+#include <isometry/serialization.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+std::string logPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() /
+          ("isometry_pose_log_" + name))
+      .string();
+}
+
+std::vector<Isometry> trajectory(const int size) {
+  std::vector<Isometry> poses;
+  for (int i = 0; i < size; ++i) {
+    poses.emplace_back(
+        Vector3{0.1 * i, -0.2 * i, 1.},
+        Isometry::rotateAround(Vector3::kUnitZ, 0.01 * i).rotation());
+  }
+  return poses;
+}
+
+GTEST_TEST(PoseLogTest, RoundTrip) {
+  const std::string path{logPath("round_trip")};
+  const std::vector<Isometry> poses{trajectory(100)};
+  {
+    // A buffer smaller than the log forces several block writes.
+    IsometryLogWriter writer{path, 16};
+    for (int i = 0; i < 50; ++i) {
+      writer.append(poses[i]);
+    }
+    writer.append(std::span<const Isometry>(poses).subspan(50));
+    EXPECT_EQ(writer.size(), poses.size());
+  }
+  const IsometryLogReader reader{path};
+  ASSERT_EQ(reader.size(), poses.size());
+  for (std::size_t i = 0; i < poses.size(); ++i) {
+    EXPECT_EQ(reader[i], poses[i]);
+  }
+  // Records are usable in place.
+  const Vector3 p{1., 2., 3.};
+  EXPECT_EQ(reader[10].compose(reader[20]).transform(p),
+            poses[10] * (poses[20] * p));
+}
+
+GTEST_TEST(PoseLogTest, SerializationCompatible) {
+  const std::string path{logPath("serialization")};
+  const std::vector<Vector3> points{Vector3{1., 2., 3.}, Vector3{4., 5., 6.}};
+  {
+    Vector3LogWriter writer{path};
+    writer.append(points);
+  }
+  std::ifstream file{path, std::ios::binary};
+  const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(file),
+                                        std::istreambuf_iterator<char>()};
+  EXPECT_EQ(serialization::decodeVector3s(bytes), points);
+
+  const Vector3LogReader reader{path};
+  EXPECT_EQ(std::vector<Vector3>(reader.records().begin(),
+                                 reader.records().end()),
+            points);
+}
+
+GTEST_TEST(PoseLogTest, FlushPublishesRecords) {
+  const std::string path{logPath("flush")};
+  const std::vector<Isometry> poses{trajectory(10)};
+  IsometryLogWriter writer{path};
+  EXPECT_TRUE(IsometryLogReader{path}.empty());
+
+  writer.append(std::span<const Isometry>(poses).first(4));
+  writer.flush();
+  writer.append(poses[4]);
+  EXPECT_EQ(IsometryLogReader{path}.size(), 4u);
+
+  writer.close();
+  IsometryLogReader reader{path};
+  EXPECT_EQ(reader.size(), 5u);
+  EXPECT_THROW(writer.append(poses[5]), std::logic_error);
+
+  // Moving transfers the mapping.
+  IsometryLogReader moved{std::move(reader)};
+  EXPECT_EQ(moved.size(), 5u);
+  EXPECT_EQ(moved[4], poses[4]);
+}
+
+// Writes past the file size limit fail with EFBIG once a short write has
+// reached it, which leaves a partial record behind.
+GTEST_TEST(PoseLogTest, FailedWritesKeepWholeRecords) {
+  const std::string path{logPath("failed_writes")};
+  const std::vector<Isometry> poses{trajectory(40)};
+  const std::span<const Isometry> all{poses};
+  IsometryLogWriter writer{path, 16};
+  writer.append(all.first(5));
+  writer.flush();
+
+  struct rlimit original;
+  ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &original), 0);
+  struct rlimit limited{original};
+  limited.rlim_cur = serialization::kHeaderSize + 10 * sizeof(Isometry) +
+                     sizeof(Isometry) / 2;
+  const auto handler{std::signal(SIGXFSZ, SIG_IGN)};
+  ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limited), 0);
+
+  // A large block is dropped.
+  EXPECT_THROW(writer.append(all.subspan(5, 20)), std::system_error);
+  EXPECT_EQ(std::filesystem::file_size(path),
+            serialization::kHeaderSize + 5 * sizeof(Isometry));
+  EXPECT_EQ(IsometryLogReader{path}.size(), 5u);
+  // Buffered records are kept for a later flush.
+  for (int i = 5; i < 20; ++i) {
+    writer.append(poses[i]);
+  }
+  EXPECT_THROW(writer.append(poses[20]), std::system_error);
+  EXPECT_EQ(std::filesystem::file_size(path),
+            serialization::kHeaderSize + 5 * sizeof(Isometry));
+
+  ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &original), 0);
+  std::signal(SIGXFSZ, handler);
+  writer.close();
+  const IsometryLogReader reader{path};
+  ASSERT_EQ(reader.size(), 21u);
+  for (std::size_t i = 0; i < reader.size(); ++i) {
+    EXPECT_EQ(reader[i], poses[i]);
+  }
+}
+
+GTEST_TEST(PoseLogTest, InvalidLogs) {
+  EXPECT_THROW(IsometryLogReader{logPath("missing")}, std::system_error);
+
+  const std::string vectors{logPath("vectors")};
+  Vector3LogWriter{vectors}.append(Vector3::kUnitX);
+  EXPECT_THROW(IsometryLogReader{vectors}, std::invalid_argument);
+
+  const std::string garbage{logPath("garbage")};
+  std::ofstream{garbage} << "not a pose log at all";
+  EXPECT_THROW(IsometryLogReader{garbage}, std::invalid_argument);
+
+  // A header announcing more records than the file holds.
+  const std::string truncated{logPath("truncated")};
+  {
+    std::vector<std::uint8_t> bytes;
+    serialization::encode(trajectory(3), bytes);
+    bytes.resize(bytes.size() - 1);
+    std::ofstream file{truncated, std::ios::binary};
+    file.write(reinterpret_cast<const char *>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+  }
+  EXPECT_THROW(IsometryLogReader{truncated}, std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,114 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the float and long double instantiations, and the casts between
+ * scalar types.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+
+#include <isometry/isometry.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+// Changing precision is always explicit.
+static_assert(!std::is_convertible_v<Vector3f, Vector3>);
+static_assert(!std::is_convertible_v<Vector3, Vector3f>);
+static_assert(!std::is_convertible_v<Matrix3l, Matrix3>);
+static_assert(!std::is_convertible_v<Isometryf, Isometry>);
+static_assert(sizeof(Vector3f) == 3 * sizeof(float));
+static_assert(sizeof(Matrix3f) == 9 * sizeof(float));
+static_assert(sizeof(Isometryf) == 12 * sizeof(float));
+
+// The constexpr interface works for every scalar type.
+constexpr Isometryf kShift{Isometryf::fromTranslation(Vector3f{1.f, 2.f, 3.f})};
+static_assert(kShift * Vector3f::kUnitX == Vector3f{2.f, 2.f, 3.f});
+static_assert(Matrix3l::kIdentity.product(Matrix3l::kOnes) == Matrix3l::kOnes);
+
+// Rounding differences between equivalent expressions grow with the number
+// of operations, so these compare within a few epsilons.
+template <typename T>
+void expectNear(const BasicVector3<T> &lhs, const BasicVector3<T> &rhs) {
+  EXPECT_LE((lhs - rhs).eval().norm(),
+            16 * std::numeric_limits<T>::epsilon() *
+                std::max(T{1}, rhs.norm()));
+}
+
+template <typename T>
+void checkRigidOperations() {
+  using Vector = BasicVector3<T>;
+  using Transform = BasicIsometry<T>;
+  const Transform t1{Vector{1, 2, 3},
+                     Transform::rotateAround(Vector::kUnitZ, T{0.5})
+                         .rotation()};
+  const Transform t2{Transform::fromEulerAngles(T{0.1}, T{-0.2}, T{0.3})};
+  const Vector p{T{0.5}, T{-1}, T{2}};
+
+  expectNear((t1 * t2) * p, t1 * (t2 * p));
+  expectNear(t1.inverse() * (t1 * p), p);
+  expectNear((t1 * t1.inverse()).translation(), Vector::kZero);
+  EXPECT_NEAR(t2.rotation().det(), T{1},
+              16 * std::numeric_limits<T>::epsilon());
+
+  Vector v{p};
+  v += T{2} * p - p / T{2};
+  EXPECT_EQ(v, Vector(T{1.25}, T{-2.5}, T{5}));
+  EXPECT_EQ(v.norm(), std::sqrt(v.dot(v)));
+}
+
+GTEST_TEST(PrecisionTest, Float) { checkRigidOperations<float>(); }
+
+GTEST_TEST(PrecisionTest, LongDouble) { checkRigidOperations<long double>(); }
+
+GTEST_TEST(PrecisionTest, Casts) {
+  const Isometry isometry{Isometry::fromEulerAngles(0.1, -0.2, 0.3) *
+                          Isometry::fromTranslation(Vector3{1., 2., 3.})};
+
+  const Isometryf narrowed{isometry.cast<float>()};
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(narrowed.translation()[i],
+              static_cast<float>(isometry.translation()[i]));
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_EQ(narrowed.rotation()[i][j],
+                static_cast<float>(isometry.rotation()[i][j]));
+    }
+  }
+
+  // Widening is exact, so going through long double and back is lossless.
+  const Isometryl widened{isometry.cast<long double>()};
+  const Isometry round_trip{widened.cast<double>()};
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(round_trip.translation()[i], isometry.translation()[i]);
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_EQ(round_trip.rotation()[i][j], isometry.rotation()[i][j]);
+    }
+  }
+  EXPECT_EQ(Vector3f(1.f, 2.f, 3.f).cast<double>(), Vector3(1., 2., 3.));
+  EXPECT_EQ(Matrix3::kIdentity.cast<float>(), Matrix3f::kIdentity);
+}
+
+GTEST_TEST(PrecisionTest, Streams) {
+  std::ostringstream os;
+  os << Isometryf::fromTranslation(Vector3f{1.5f, 0.f, -2.f});
+  EXPECT_EQ(os.str(),
+            "[T: (x: 1.5, y: 0, z: -2), R:[[1, 0, 0], [0, 1, 0], [0, 0, 1]]]");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,177 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for Quaternion and the quaternion backed QuaternionIsometry.
+ */
+
+#include <cmath>
+#include <sstream>
+
+#include <isometry/quaternion.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+const double kTolerance{1e-12};
+
+testing::AssertionResult areAlmostEqual(const Matrix3 &obj1,
+                                        const Matrix3 &obj2,
+                                        const double tolerance) {
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      if (std::abs(obj1[i][j] - obj2[i][j]) > tolerance) {
+        return testing::AssertionFailure()
+               << obj1 << " and " << obj2 << " are not almost equal";
+      }
+    }
+  }
+  return testing::AssertionSuccess();
+}
+
+testing::AssertionResult areAlmostEqual(const Vector3 &obj1,
+                                        const Vector3 &obj2,
+                                        const double tolerance) {
+  if ((obj1 - obj2).eval().norm() > tolerance) {
+    return testing::AssertionFailure()
+           << obj1 << " and " << obj2 << " are not almost equal";
+  }
+  return testing::AssertionSuccess();
+}
+
+GTEST_TEST(QuaternionTest, HamiltonProduct) {
+  const Quaternion i{0., 1., 0., 0.};
+  const Quaternion j{0., 0., 1., 0.};
+  const Quaternion k{0., 0., 0., 1.};
+  const Quaternion minus_one{-1., 0., 0., 0.};
+  EXPECT_EQ(i * i, minus_one);
+  EXPECT_EQ(j * j, minus_one);
+  EXPECT_EQ(k * k, minus_one);
+  EXPECT_EQ(i * j * k, minus_one);
+  EXPECT_EQ(i * j, k);
+  EXPECT_EQ(j * i, -k);
+  EXPECT_EQ(Quaternion::kIdentity * i, i);
+  EXPECT_EQ(i * i.conjugate(), Quaternion::kIdentity);
+
+  Quaternion q{i};
+  q *= j;
+  EXPECT_EQ(q, k);
+}
+
+GTEST_TEST(QuaternionTest, Normalization) {
+  Quaternion q{1., 2., 3., 4.};
+  EXPECT_DOUBLE_EQ(q.norm(), std::sqrt(30.));
+  EXPECT_DOUBLE_EQ(q.normalized().norm(), 1.);
+  EXPECT_DOUBLE_EQ(q.normalize().norm(), 1.);
+  EXPECT_DOUBLE_EQ(q.w(), 1. / std::sqrt(30.));
+  EXPECT_THROW(Quaternion(0., 0., 0., 0.).normalize(), std::domain_error);
+}
+
+GTEST_TEST(QuaternionTest, RotationsMatchRotationMatrices) {
+  const Vector3 axis{1., -2., 0.5};
+  const double angle{0.7};
+  const Quaternion q{Quaternion::fromAxisAngle(axis, angle)};
+  const Matrix3 r{Isometry::rotateAround(axis, angle).rotation()};
+  const Vector3 p{3., 4., -5.};
+
+  EXPECT_NEAR(q.norm(), 1., kTolerance);
+  EXPECT_TRUE(areAlmostEqual(q.toRotationMatrix(), r, kTolerance));
+  EXPECT_TRUE(areAlmostEqual(q.rotate(p), r * p, kTolerance));
+  EXPECT_THROW(Quaternion::fromAxisAngle(Vector3::kZero, 1.),
+               std::invalid_argument);
+}
+
+GTEST_TEST(QuaternionTest, RoundTripsThroughRotationMatrices) {
+  // Covers each of the branches of the matrix to quaternion conversion.
+  const Vector3 axes[]{Vector3::kUnitX, Vector3::kUnitY, Vector3::kUnitZ,
+                       Vector3{1., 1., 1.}};
+  for (const Vector3 &axis : axes) {
+    for (const double angle : {0., 0.5, 2.5, M_PI}) {
+      const Quaternion q{Quaternion::fromAxisAngle(axis, angle)};
+      const Quaternion converted{
+          Quaternion::fromRotationMatrix(q.toRotationMatrix())};
+      EXPECT_NEAR(std::abs(q.dot(converted)), 1., kTolerance)
+          << "axis " << axis << ", angle " << angle;
+    }
+  }
+}
+
+GTEST_TEST(QuaternionTest, Serialization) {
+  std::stringstream ss;
+  ss << Quaternion{1., 0.5, -2., 3.};
+  EXPECT_EQ(ss.str(), "(w: 1, x: 0.5, y: -2, z: 3)");
+}
+
+GTEST_TEST(QuaternionIsometryTest, MatchesIsometry) {
+  const Isometry t1{Vector3{1., 2., 3.},
+                    Isometry::fromEulerAngles(0.3, -1.2, 2.).rotation()};
+  const Isometry t2{
+      Vector3{-4., 0.5, 1.},
+      Isometry::rotateAround(Vector3{1., 1., 0.}, 0.9).rotation()};
+  const QuaternionIsometry q1{t1};
+  const QuaternionIsometry q2{t2};
+  const Vector3 p{0.5, -1., 2.};
+
+  EXPECT_TRUE(areAlmostEqual(q1.rotation(), t1.rotation(), kTolerance));
+  EXPECT_TRUE(areAlmostEqual(q1 * p, t1 * p, kTolerance));
+  EXPECT_TRUE(areAlmostEqual((q1 * q2) * p, (t1 * t2) * p, kTolerance));
+  EXPECT_TRUE(areAlmostEqual((q1 * q2).rotation(), (t1 * t2).rotation(),
+                             kTolerance));
+  EXPECT_TRUE(areAlmostEqual(q1.inverse() * (q1 * p), p, kTolerance));
+  EXPECT_TRUE(
+      areAlmostEqual(q1.inverse().toIsometry().translation(),
+                     t1.inverse().translation(), kTolerance));
+
+  const QuaternionIsometry euler{
+      QuaternionIsometry::fromEulerAngles(0.3, -1.2, 2.)};
+  EXPECT_TRUE(areAlmostEqual(euler.rotation(), t1.rotation(), kTolerance));
+}
+
+GTEST_TEST(QuaternionIsometryTest, CompositionAndComparison) {
+  const QuaternionIsometry t1{
+      QuaternionIsometry::fromTranslation(Vector3{1., 2., 3.})};
+  const QuaternionIsometry t2{Vector3{1., 2., 3.}, Quaternion::kIdentity};
+  EXPECT_EQ(t1, t2);
+  EXPECT_EQ(t1 * Vector3(1., 1., 1.), Vector3(2., 3., 4.));
+  EXPECT_EQ(t1 * t2 * Vector3(1., 1., 1.), Vector3(3., 5., 7.));
+  EXPECT_NE(t1 * t2, t1);
+
+  // q and -q are the same rotation.
+  const QuaternionIsometry t3{Vector3{1., 2., 3.}, -Quaternion::kIdentity};
+  EXPECT_EQ(t1, t3);
+
+  QuaternionIsometry t4{t1};
+  t4 *= t2;
+  EXPECT_EQ(t4, t1 * t2);
+}
+
+GTEST_TEST(QuaternionIsometryTest, NormalizeAfterLongChains) {
+  const QuaternionIsometry step{
+      QuaternionIsometry::rotateAround(Vector3{1., 2., 3.}, 0.01)};
+  QuaternionIsometry chain;
+  for (int i = 0; i < 100000; ++i) {
+    chain *= step;
+  }
+  chain.normalize();
+  EXPECT_NEAR(chain.quaternion().norm(), 1., kTolerance);
+}
+
+GTEST_TEST(QuaternionIsometryTest, Serialization) {
+  std::stringstream ss;
+  ss << QuaternionIsometry::fromTranslation(Vector3{1., 2., 3.});
+  EXPECT_EQ(ss.str(),
+            "[T: (x: 1, y: 2, z: 3), Q:(w: 1, x: 0, y: 0, z: 0)]");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,165 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the binary encoding of vectors, matrices and isometries.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <isometry/serialization.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace serialization {
+namespace test {
+namespace {
+
+const Isometry kIsometry{
+    Vector3{1.5, -2., 1e-300},
+    Isometry::fromEulerAngles(0.1, -0.7, 2.3).rotation()};
+
+// Whether |lhs| and |rhs| are the same bits, which is what exact round trips
+// must preserve.
+template <typename T>
+bool sameBits(const T &lhs, const T &rhs) {
+  return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+}
+
+// Whether |lhs| and |rhs| differ only by the rounding of the compact
+// encoding.
+bool nearlyEqual(const Isometry &lhs, const Isometry &rhs) {
+  if (!sameBits(lhs.translation(), rhs.translation())) {
+    return false;
+  }
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      if (std::abs(lhs.rotation()[i][j] - rhs.rotation()[i][j]) > 1e-15) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+GTEST_TEST(SerializationTest, LittleEndianLayout) {
+  std::uint8_t buffer[kVector3Size];
+  EXPECT_EQ(encode(Vector3{1., -2., 0.}, buffer), kVector3Size);
+  // 1.0 is 0x3FF0000000000000, -2.0 is 0xC000000000000000.
+  const std::uint8_t expected[kVector3Size]{
+      0, 0, 0, 0, 0, 0, 0xF0, 0x3F, 0, 0, 0, 0, 0, 0, 0, 0xC0,
+      0, 0, 0, 0, 0, 0, 0,    0};
+  EXPECT_EQ(std::memcmp(buffer, expected, kVector3Size), 0);
+}
+
+GTEST_TEST(SerializationTest, SingleValueRoundTrips) {
+  std::uint8_t buffer[kIsometrySize];
+  const Vector3 v{0.1, -1e10, M_PI};
+  EXPECT_EQ(encode(v, buffer), kVector3Size);
+  EXPECT_TRUE(sameBits(decodeVector3(buffer), v));
+
+  const Matrix3 m{1., 2., 3., 4., 5., 6., 7., 8., 1. / 3.};
+  EXPECT_EQ(encode(m, buffer), kMatrix3Size);
+  EXPECT_TRUE(sameBits(decodeMatrix3(buffer), m));
+
+  EXPECT_EQ(encode(kIsometry, buffer), kIsometrySize);
+  EXPECT_TRUE(sameBits(decodeIsometry(buffer), kIsometry));
+}
+
+GTEST_TEST(SerializationTest, CompactIsometries) {
+  std::uint8_t buffer[kCompactIsometrySize];
+  EXPECT_EQ(encodeCompact(kIsometry, buffer), kCompactIsometrySize);
+  EXPECT_TRUE(nearlyEqual(decodeCompactIsometry(buffer), kIsometry));
+
+  // The quaternion follows the translation.
+  std::memset(buffer + kVector3Size, 0, 4 * sizeof(double));
+  EXPECT_THROW(decodeCompactIsometry(buffer), std::invalid_argument);
+  std::vector<std::uint8_t> array;
+  encodeCompact(std::vector<Isometry>{kIsometry}, array);
+  std::memset(array.data() + kHeaderSize + kVector3Size, 0xFF,
+              sizeof(double));
+  EXPECT_THROW(decodeCompactIsometries(array), std::invalid_argument);
+}
+
+GTEST_TEST(SerializationTest, ArrayRoundTrips) {
+  const std::vector<Vector3> vectors{Vector3{1., 2., 3.}, Vector3{-1., 0., 4.}};
+  const std::vector<Matrix3> matrices{Matrix3::kIdentity, Matrix3::kOnes};
+  const std::vector<Isometry> isometries{
+      kIsometry, kIsometry.inverse(),
+      Isometry::fromTranslation(Vector3{4., 5., 6.})};
+
+  std::vector<std::uint8_t> buffer;
+  encode(vectors, buffer);
+  EXPECT_EQ(buffer.size(), kHeaderSize + 2 * kVector3Size);
+  EXPECT_EQ(buffer[4], kFormatVersion);
+  EXPECT_EQ(decodeVector3s(buffer), vectors);
+
+  buffer.clear();
+  encode(matrices, buffer);
+  EXPECT_EQ(decodeMatrix3s(buffer), matrices);
+
+  buffer.clear();
+  encode(isometries, buffer);
+  EXPECT_EQ(buffer.size(), kHeaderSize + 3 * kIsometrySize);
+  const std::vector<Isometry> decoded{decodeIsometries(buffer)};
+  ASSERT_EQ(decoded.size(), isometries.size());
+  for (std::size_t i = 0; i < decoded.size(); ++i) {
+    EXPECT_TRUE(sameBits(decoded[i], isometries[i]));
+  }
+
+  buffer.clear();
+  encodeCompact(isometries, buffer);
+  EXPECT_EQ(buffer.size(), kHeaderSize + 3 * kCompactIsometrySize);
+  const std::vector<Isometry> compact{decodeCompactIsometries(buffer)};
+  ASSERT_EQ(compact.size(), isometries.size());
+  for (std::size_t i = 0; i < compact.size(); ++i) {
+    EXPECT_TRUE(nearlyEqual(compact[i], isometries[i]));
+  }
+
+  buffer.clear();
+  encode(std::vector<Isometry>{}, buffer);
+  EXPECT_TRUE(decodeIsometries(buffer).empty());
+}
+
+GTEST_TEST(SerializationTest, MalformedArrays) {
+  std::vector<std::uint8_t> buffer;
+  encode(std::vector<Vector3>{Vector3::kUnitX}, buffer);
+
+  EXPECT_THROW(decodeMatrix3s(buffer), std::invalid_argument);
+  EXPECT_THROW(decodeVector3s(std::span<const std::uint8_t>(buffer).first(10)),
+               std::invalid_argument);
+  EXPECT_THROW(
+      decodeVector3s(std::span<const std::uint8_t>(buffer).first(30)),
+      std::invalid_argument);
+
+  std::vector<std::uint8_t> corrupted{buffer};
+  corrupted[0] = 'X';
+  EXPECT_THROW(decodeVector3s(corrupted), std::invalid_argument);
+
+  corrupted = buffer;
+  corrupted[4] = kFormatVersion + 1;
+  EXPECT_THROW(decodeVector3s(corrupted), std::invalid_argument);
+
+  // A record count that would overflow when multiplied by the record size.
+  corrupted = buffer;
+  for (int i = 8; i < 16; ++i) {
+    corrupted[i] = 0xFF;
+  }
+  EXPECT_THROW(decodeVector3s(corrupted), std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace serialization
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
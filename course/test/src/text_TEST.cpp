@@ -0,0 +1,144 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the allocation-free text formatting and parsing.
+ */
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+#include <isometry/text.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+const Isometry kIsometry{
+    Vector3{0.1, -std::numeric_limits<double>::denorm_min(), 1e300},
+    Isometry::fromEulerAngles(0.1, -0.7, 2.3).rotation()};
+
+template <typename T>
+std::string format(const T &value) {
+  char buffer[kIsometryMaxChars];
+  const std::to_chars_result result{
+      toChars(buffer, buffer + sizeof(buffer), value)};
+  EXPECT_EQ(result.ec, std::errc{});
+  return std::string(buffer, result.ptr);
+}
+
+template <typename T>
+T parse(const std::string &text) {
+  T value;
+  const std::from_chars_result result{
+      fromChars(text.data(), text.data() + text.size(), value)};
+  EXPECT_EQ(result.ec, std::errc{});
+  EXPECT_EQ(result.ptr, text.data() + text.size());
+  return value;
+}
+
+GTEST_TEST(TextTest, MatchesTheStreamFormat) {
+  const Vector3 v{1., -2.5, 3.};
+  EXPECT_EQ(format(v), "(x: 1, y: -2.5, z: 3)");
+  std::ostringstream os;
+  os << Matrix3::kIdentity;
+  EXPECT_EQ(format(Matrix3::kIdentity), os.str());
+  os.str("");
+  os << Isometry::fromTranslation(v);
+  EXPECT_EQ(format(Isometry::fromTranslation(v)), os.str());
+}
+
+GTEST_TEST(TextTest, RoundTrips) {
+  const Vector3 v{kIsometry.translation()};
+  EXPECT_EQ(format(v), "(x: 0.1, y: -5e-324, z: 1e+300)");
+  const Vector3 parsed_v{parse<Vector3>(format(v))};
+  EXPECT_TRUE((parsed_v.x() == v.x()) && (parsed_v.y() == v.y()) &&
+              (parsed_v.z() == v.z()));
+
+  const Matrix3 parsed_m{parse<Matrix3>(format(kIsometry.rotation()))};
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_EQ(parsed_m[i][j], kIsometry.rotation()[i][j]);
+    }
+  }
+
+  const Isometry parsed{parse<Isometry>(format(kIsometry))};
+  EXPECT_EQ(format(parsed), format(kIsometry));
+}
+
+GTEST_TEST(TextTest, ParsesStreamOutputAndWhitespace) {
+  const Isometry isometry{Vector3{1.5, -2., 1e-3},
+                          Matrix3{0., -1., 0., 1., 0., 0., 0., 0., 1.}};
+  std::ostringstream os;
+  os << isometry;
+  EXPECT_EQ(parse<Isometry>(os.str()), isometry);
+
+  const Vector3 v{parse<Vector3>("  ( x:1 ,y : -2e1,\n z:  3.5 )")};
+  EXPECT_EQ(v, Vector3(1., -20., 3.5));
+  EXPECT_EQ(parse<Isometry>("[T: (x: 1, y: 2, z: 3), R: [[1, 0, 0], "
+                            "[0, 1, 0], [0, 0, 1]]]"),
+            Isometry::fromTranslation(Vector3(1., 2., 3.)));
+}
+
+GTEST_TEST(TextTest, BufferTooSmall) {
+  char buffer[kIsometryMaxChars];
+  const std::string text{format(kIsometry)};
+  EXPECT_LE(text.size(), kIsometryMaxChars);
+  const std::to_chars_result result{
+      toChars(buffer, buffer + text.size() - 1, kIsometry)};
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+  EXPECT_EQ(result.ptr, buffer + text.size() - 1);
+
+  // Every character of the worst case is needed.
+  const double worst{-std::numeric_limits<double>::min()};
+  const Vector3 v{worst, worst, worst};
+  EXPECT_EQ(format(v).size(), kVector3MaxChars);
+  const Matrix3 m{worst, worst, worst, worst, worst,
+                  worst, worst, worst, worst};
+  EXPECT_EQ(format(m).size(), kMatrix3MaxChars);
+  EXPECT_EQ(format(Isometry{v, m}).size(), kIsometryMaxChars);
+}
+
+GTEST_TEST(TextTest, MalformedText) {
+  const Vector3 original{1., 2., 3.};
+  for (const std::string text :
+       {"", "(x: 1, y: 2)", "(x: 1, y: 2, z: )", "[x: 1, y: 2, z: 3]",
+        "(x: 1, y: 2, z: 3"}) {
+    Vector3 v{original};
+    const std::from_chars_result result{
+        fromChars(text.data(), text.data() + text.size(), v)};
+    EXPECT_EQ(result.ec, std::errc::invalid_argument) << text;
+    EXPECT_EQ(result.ptr, text.data()) << text;
+    EXPECT_EQ(v, original) << text;
+  }
+
+  const std::string out_of_range{"(x: 1, y: 1e999, z: 3)"};
+  Vector3 v{original};
+  const std::from_chars_result result{fromChars(
+      out_of_range.data(), out_of_range.data() + out_of_range.size(), v)};
+  EXPECT_EQ(result.ec, std::errc::result_out_of_range);
+  EXPECT_EQ(result.ptr, out_of_range.data() + 15);
+  EXPECT_EQ(v, original);
+
+  // Trailing text is left for the caller.
+  const std::string trailing{"(x: 1, y: 2, z: 3) tail"};
+  const std::from_chars_result partial{
+      fromChars(trailing.data(), trailing.data() + trailing.size(), v)};
+  EXPECT_EQ(partial.ec, std::errc{});
+  EXPECT_EQ(std::string(partial.ptr), " tail");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,152 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the work-stealing ThreadPool.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <isometry/thread_pool.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+ThreadPool::Options smallChunks() {
+  ThreadPool::Options options;
+  options.chunk_size = 7;
+  options.serial_threshold = 0;
+  return options;
+}
+
+// Checks that a loop over |count| indices visits each exactly once.
+void expectVisitsAll(ThreadPool &pool, const std::size_t count) {
+  std::vector<std::atomic<int>> visits(count);
+  pool.parallelFor(count, [&](const std::size_t begin, const std::size_t end) {
+    ASSERT_LT(begin, end);
+    ASSERT_LE(end, count);
+    for (std::size_t i = begin; i < end; ++i) {
+      visits[i].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+  for (std::size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(visits[i].load(), 1) << "index " << i << " of " << count;
+  }
+}
+
+GTEST_TEST(ThreadPoolTest, Construction) {
+  EXPECT_THROW(ThreadPool{0}, std::invalid_argument);
+  ThreadPool::Options options;
+  options.chunk_size = 0;
+  EXPECT_THROW(ThreadPool(2, options), std::invalid_argument);
+  EXPECT_EQ(ThreadPool{3}.size(), 3u);
+  EXPECT_GE(ThreadPool::global().size(), 1u);
+}
+
+GTEST_TEST(ThreadPoolTest, VisitsEveryIndexOnce) {
+  ThreadPool pool{4, smallChunks()};
+  for (const std::size_t count : {0, 1, 6, 7, 8, 27, 28, 29, 1000, 12345}) {
+    expectVisitsAll(pool, count);
+  }
+  ThreadPool single{1, smallChunks()};
+  expectVisitsAll(single, 100);
+}
+
+GTEST_TEST(ThreadPoolTest, ShortLoopsRunOnTheCaller) {
+  ThreadPool::Options options;
+  options.serial_threshold = 100;
+  ThreadPool pool{4, options};
+  const std::thread::id caller{std::this_thread::get_id()};
+  pool.parallelFor(99, [&](const std::size_t begin, const std::size_t end) {
+    EXPECT_EQ(begin, 0u);
+    EXPECT_EQ(end, 99u);
+    EXPECT_EQ(std::this_thread::get_id(), caller);
+  });
+}
+
+GTEST_TEST(ThreadPoolTest, IdleThreadsStealWork) {
+  ThreadPool pool{4, smallChunks()};
+  // The first share is much slower than the rest, so that the other
+  // threads end up stealing from it.
+  std::vector<std::thread::id> owners(7 * 40);
+  pool.parallelFor(owners.size(),
+                   [&](const std::size_t begin, const std::size_t end) {
+                     if (begin < owners.size() / 4) {
+                       std::this_thread::sleep_for(
+                           std::chrono::milliseconds(2));
+                     }
+                     for (std::size_t i = begin; i < end; ++i) {
+                       owners[i] = std::this_thread::get_id();
+                     }
+                   });
+  std::vector<std::thread::id> first_share_owners;
+  for (std::size_t i = 0; i < owners.size() / 4; ++i) {
+    if (std::find(first_share_owners.begin(), first_share_owners.end(),
+                  owners[i]) == first_share_owners.end()) {
+      first_share_owners.push_back(owners[i]);
+    }
+  }
+  EXPECT_GT(first_share_owners.size(), 1u);
+}
+
+GTEST_TEST(ThreadPoolTest, NestedLoopsAndExceptions) {
+  ThreadPool pool{4, smallChunks()};
+  std::atomic<std::size_t> total{0};
+  pool.parallelFor(10, [&](const std::size_t begin, const std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      pool.parallelFor(10, [&](const std::size_t b, const std::size_t e) {
+        total.fetch_add(e - b, std::memory_order_relaxed);
+      });
+    }
+  });
+  EXPECT_EQ(total.load(), 100u);
+
+  std::atomic<std::size_t> visited{0};
+  EXPECT_THROW(
+      pool.parallelFor(
+          1000,
+          [&](const std::size_t begin, const std::size_t end) {
+            visited.fetch_add(end - begin, std::memory_order_relaxed);
+            if (begin == 0) {
+              throw std::runtime_error("failed chunk");
+            }
+          }),
+      std::runtime_error);
+  EXPECT_EQ(visited.load(), 1000u);
+  // The pool is still usable afterwards.
+  expectVisitsAll(pool, 500);
+}
+
+GTEST_TEST(ThreadPoolTest, ConcurrentCallers) {
+  ThreadPool pool{3, smallChunks()};
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; ++i) {
+    callers.emplace_back([&pool] {
+      for (int j = 0; j < 20; ++j) {
+        expectVisitsAll(pool, 300);
+      }
+    });
+  }
+  for (std::thread &caller : callers) {
+    caller.join();
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,141 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the time-stamped isometry ring buffer.
+ */
+
+#include <cmath>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+
+#include <isometry/timed_isometry_buffer.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+const double kTolerance{1e-12};
+
+Isometry poseAt(const double time) {
+  return Isometry{Vector3{time, 2. * time, 0.},
+                  Isometry::rotateAround(Vector3::kUnitZ, 0.1 * time)
+                      .rotation()};
+}
+
+testing::AssertionResult areAlmostEqual(const Isometry &obj1,
+                                        const Isometry &obj2,
+                                        const double tolerance) {
+  for (int i = 0; i < 3; ++i) {
+    if (std::abs(obj1.translation()[i] - obj2.translation()[i]) > tolerance) {
+      return testing::AssertionFailure()
+             << obj1 << " and " << obj2 << " are not almost equal";
+    }
+    for (int j = 0; j < 3; ++j) {
+      if (std::abs(obj1.rotation()[i][j] - obj2.rotation()[i][j]) >
+          tolerance) {
+        return testing::AssertionFailure()
+               << obj1 << " and " << obj2 << " are not almost equal";
+      }
+    }
+  }
+  return testing::AssertionSuccess();
+}
+
+GTEST_TEST(TimedIsometryBufferTest, Bookkeeping) {
+  EXPECT_THROW(TimedIsometryBuffer(0), std::invalid_argument);
+
+  TimedIsometryBuffer buffer{3};
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.capacity(), 3u);
+  EXPECT_THROW(buffer.oldestTime(), std::out_of_range);
+  EXPECT_THROW(buffer.lookup(0.), std::out_of_range);
+
+  buffer.insert(1., poseAt(1.));
+  buffer.insert(2., poseAt(2.));
+  EXPECT_EQ(buffer.size(), 2u);
+  EXPECT_EQ(buffer.oldestTime(), 1.);
+  EXPECT_EQ(buffer.newestTime(), 2.);
+  EXPECT_THROW(buffer.insert(1.5, poseAt(1.5)), std::invalid_argument);
+  EXPECT_THROW(buffer.insert(std::nan(""), poseAt(3.)), std::invalid_argument);
+  EXPECT_THROW(buffer.insert(INFINITY, poseAt(3.)), std::invalid_argument);
+  EXPECT_THROW(buffer.lookup(std::nan("")), std::out_of_range);
+  EXPECT_EQ(buffer.size(), 2u);
+
+  // Full buffers drop the oldest entry.
+  buffer.insert(3., poseAt(3.));
+  buffer.insert(4., poseAt(4.));
+  EXPECT_EQ(buffer.size(), 3u);
+  EXPECT_EQ(buffer.oldestTime(), 2.);
+  EXPECT_EQ(buffer.newestTime(), 4.);
+  EXPECT_THROW(buffer.lookup(1.5), std::out_of_range);
+  EXPECT_THROW(buffer.lookup(4.5), std::out_of_range);
+
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+  buffer.insert(0., poseAt(0.));
+  EXPECT_EQ(buffer.oldestTime(), 0.);
+}
+
+GTEST_TEST(TimedIsometryBufferTest, ExactLookups) {
+  TimedIsometryBuffer buffer{4};
+  for (int i = 0; i < 10; ++i) {
+    buffer.insert(i, poseAt(i));
+  }
+  for (int i = 6; i < 10; ++i) {
+    EXPECT_TRUE(areAlmostEqual(buffer.lookup(i), poseAt(i), kTolerance));
+  }
+  // Inserting at the newest timestamp replaces that entry.
+  buffer.insert(9., poseAt(20.));
+  EXPECT_EQ(buffer.size(), 4u);
+  EXPECT_TRUE(areAlmostEqual(buffer.lookup(9.), poseAt(20.), kTolerance));
+}
+
+GTEST_TEST(TimedIsometryBufferTest, InterpolatedLookups) {
+  TimedIsometryBuffer buffer{8};
+  for (int i = 0; i < 20; ++i) {
+    buffer.insert(0.5 * i, poseAt(0.5 * i));
+  }
+  // poseAt() moves at a constant speed and rotates at a constant rate around
+  // a fixed axis, so lerp and slerp reproduce it exactly.
+  for (const double time : {6.1, 7.25, 8.9, 9.4}) {
+    EXPECT_TRUE(areAlmostEqual(buffer.lookup(time), poseAt(time), kTolerance))
+        << "time " << time;
+  }
+}
+
+GTEST_TEST(TimedIsometryBufferTest, SlerpTakesTheShortestArc) {
+  const Quaternion from{
+      Quaternion::fromAxisAngle(Vector3::kUnitZ, 0.2)};
+  const Quaternion to{-Quaternion::fromAxisAngle(Vector3::kUnitZ, 0.6)};
+  const Quaternion middle{slerp(from, to, 0.5)};
+  const Quaternion expected{Quaternion::fromAxisAngle(Vector3::kUnitZ, 0.4)};
+  EXPECT_NEAR(std::abs(middle.dot(expected)), 1., kTolerance);
+  EXPECT_EQ(slerp(from, from, 0.3), from);
+}
+
+GTEST_TEST(TimedIsometryBufferTest, MemoryResources) {
+  std::pmr::monotonic_buffer_resource arena{std::pmr::null_memory_resource()};
+  EXPECT_THROW(TimedIsometryBuffer(4, &arena), std::bad_alloc);
+
+  alignas(8) unsigned char storage[1024];
+  std::pmr::monotonic_buffer_resource buffer_arena{
+      storage, sizeof(storage), std::pmr::null_memory_resource()};
+  TimedIsometryBuffer buffer{4, &buffer_arena};
+  buffer.insert(0., poseAt(0.));
+  buffer.insert(1., poseAt(1.));
+  EXPECT_TRUE(areAlmostEqual(buffer.lookup(1.), poseAt(1.), kTolerance));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
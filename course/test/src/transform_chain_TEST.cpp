@@ -0,0 +1,122 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the lazily evaluated TransformChain.
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <isometry/transform_chain.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+const double kTolerance{1e-12};
+
+void expectNear(const Vector3 &lhs, const Vector3 &rhs) {
+  EXPECT_NEAR((lhs - rhs).eval().norm(), 0., kTolerance)
+      << lhs << " vs " << rhs;
+}
+
+// Whether a chain can take an |Operand| isometry, in place or through the
+// binary operator.
+template <typename Operand>
+concept CompoundAppendable = requires(TransformChain chain, Operand &&operand) {
+  chain *= std::forward<Operand>(operand);
+};
+template <typename Operand>
+concept Appendable = requires(TransformChain chain, Operand &&operand) {
+  chain * std::forward<Operand>(operand);
+};
+
+// Temporaries would dangle, so only lvalues can be part of a chain.
+static_assert(std::is_constructible_v<TransformChain, const Isometry &>);
+static_assert(CompoundAppendable<const Isometry &>);
+static_assert(Appendable<const Isometry &>);
+static_assert(!std::is_constructible_v<TransformChain, Isometry>);
+static_assert(!CompoundAppendable<Isometry>);
+static_assert(!Appendable<Isometry>);
+
+struct Chain {
+  Chain()
+      : t1{Isometry::fromTranslation(Vector3{1., 2., 3.})},
+        t2{Vector3{-1., 0., 2.},
+           Isometry::rotateAround(Vector3::kUnitZ, M_PI / 3.).rotation()},
+        t3{Isometry::fromEulerAngles(0.2, -0.4, 1.1)} {}
+
+  const Isometry t1;
+  const Isometry t2;
+  const Isometry t3;
+};
+
+GTEST_TEST(TransformChainTest, SinglePoints) {
+  const Chain chain;
+  const Vector3 p{1., 1., 1.};
+  EXPECT_EQ(TransformChain{chain.t1} * chain.t2 * p, chain.t1 * chain.t2 * p);
+  expectNear(TransformChain{chain.t1} * chain.t2 * chain.t3 * p,
+             chain.t1 * (chain.t2 * (chain.t3 * p)));
+  EXPECT_EQ(TransformChain{} * p, p);
+
+  TransformChain product{chain.t3};
+  product *= chain.t1;
+  EXPECT_EQ(product.size(), 2u);
+  EXPECT_EQ(product.compose(), chain.t3 * chain.t1);
+  EXPECT_EQ(TransformChain{}.compose(),
+            Isometry::fromTranslation(Vector3::kZero));
+}
+
+GTEST_TEST(TransformChainTest, PointSpans) {
+  const Chain chain;
+  const TransformChain product{TransformChain{chain.t1} * chain.t2 * chain.t3};
+  const Isometry composed{chain.t1 * chain.t2 * chain.t3};
+  // Below and above the break-even point.
+  for (const std::size_t count :
+       {std::size_t{1}, TransformChain::kBreakEvenPoints - 1,
+        TransformChain::kBreakEvenPoints, std::size_t{100}}) {
+    std::vector<Vector3> points;
+    for (std::size_t i = 0; i < count; ++i) {
+      points.emplace_back(i, -2. * i, 0.5);
+    }
+    std::vector<Vector3> output(count);
+    product.transform(points, output);
+    for (std::size_t i = 0; i < count; ++i) {
+      expectNear(output[i], composed * points[i]);
+    }
+    product.transform(points);
+    for (std::size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(points[i], output[i]);
+    }
+  }
+  std::vector<Vector3> output(2);
+  EXPECT_THROW(product.transform(std::vector<Vector3>(3), output),
+               std::invalid_argument);
+}
+
+GTEST_TEST(TransformChainTest, LengthLimit) {
+  const Isometry shift{Isometry::fromTranslation(Vector3::kUnitX)};
+  TransformChain chain;
+  for (std::size_t i = 0; i < TransformChain::kMaxLength; ++i) {
+    chain *= shift;
+  }
+  EXPECT_EQ(chain * Vector3::kZero,
+            Vector3(TransformChain::kMaxLength, 0., 0.));
+  EXPECT_THROW(chain *= shift, std::length_error);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,68 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the unchecked element accessors of Vector3 and Matrix3.
+ */
+
+#include <isometry/isometry.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+GTEST_TEST(UncheckedTest, Vector3UncheckedAccessors) {
+  Vector3 p{1., 2., 3.};
+  EXPECT_EQ(p.atUnchecked(0), 1.);
+  EXPECT_EQ(p.atUnchecked(2), 3.);
+  EXPECT_EQ(p.get<1>(), 2.);
+  EXPECT_EQ(p.data(), &p.x());
+  EXPECT_EQ(p.data()[2], 3.);
+
+  p.atUnchecked(0) = 4.;
+  p.get<1>() = 5.;
+  p.data()[2] = 6.;
+  EXPECT_EQ(p, Vector3(4., 5., 6.));
+
+  constexpr Vector3 kP{7., 8., 9.};
+  static_assert(kP.get<2>() == 9., "get<I>() is usable at compile time");
+  static_assert(kP.atUnchecked(1) == 8., "Unchecked access at compile time");
+}
+
+GTEST_TEST(UncheckedTest, Matrix3UncheckedAccessors) {
+  Matrix3 m{1., 2., 3., 4., 5., 6., 7., 8., 9.};
+  EXPECT_EQ(m.atUnchecked(1), Vector3(4., 5., 6.));
+  EXPECT_EQ(m.atUnchecked(2, 0), 7.);
+  EXPECT_EQ(m.get<0>(), Vector3(1., 2., 3.));
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_EQ(m.data()[i], i + 1.);
+  }
+
+  m.atUnchecked(0, 0) = 0.;
+  m.get<1>().y() = 0.;
+  m.data()[8] = 0.;
+  EXPECT_EQ(m, Matrix3({0., 2., 3., 4., 0., 6., 7., 8., 0.}));
+}
+
+GTEST_TEST(UncheckedTest, CheckedAccessorsMatchUncheckedOnes) {
+  const Matrix3 m{1., 2., 3., 4., 5., 6., 7., 8., 9.};
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(m[i], m.atUnchecked(i));
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_EQ(m[i][j], m.atUnchecked(i, j));
+      EXPECT_EQ(m.col(j)[i], m.data()[3 * i + j]);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
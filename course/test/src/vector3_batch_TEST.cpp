@@ -0,0 +1,122 @@
+/* Copyright 2020, Ekumen
+ * Isometry library tests
+ * Author: Gerardo Puga, 2020
+ *
+ * Tests for the structure-of-arrays point batch and the bulk isometry
+ * transformations that operate on it.
+ */
+
+#include <cmath>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+
+#include <isometry/isometry.hpp>
+#include "gtest/gtest.h"
+
+namespace ekumen {
+namespace math {
+namespace test {
+namespace {
+
+GTEST_TEST(Vector3BatchTest, Vector3BatchContainerTests) {
+  Vector3Batch batch;
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(batch.size(), 0u);
+
+  batch.push_back(Vector3(1., 2., 3.));
+  batch.push_back(Vector3(4., 5., 6.));
+  EXPECT_FALSE(batch.empty());
+  EXPECT_EQ(batch.size(), 2u);
+  EXPECT_EQ(batch.get(0), Vector3(1., 2., 3.));
+  EXPECT_EQ(batch.get(1), Vector3(4., 5., 6.));
+
+  // Each coordinate lives in its own contiguous array.
+  EXPECT_EQ(batch.x()[0], 1.);
+  EXPECT_EQ(batch.x()[1], 4.);
+  EXPECT_EQ(batch.y()[1], 5.);
+  EXPECT_EQ(batch.z()[1], 6.);
+
+  batch.set(0, Vector3(7., 8., 9.));
+  EXPECT_EQ(batch.get(0), Vector3(7., 8., 9.));
+
+  EXPECT_ANY_THROW(batch.get(2));
+  EXPECT_ANY_THROW(batch.set(2, Vector3::kZero));
+
+  batch.resize(4);
+  EXPECT_EQ(batch.size(), 4u);
+  EXPECT_EQ(batch.get(3), Vector3::kZero);
+
+  batch.clear();
+  EXPECT_TRUE(batch.empty());
+
+  const Vector3Batch zeros(3);
+  EXPECT_EQ(zeros.size(), 3u);
+  EXPECT_EQ(zeros.get(2), Vector3::kZero);
+}
+
+GTEST_TEST(Vector3BatchTest, IsometryBatchTransformTests) {
+  const Isometry t{Vector3{1., 2., 3.},
+                   Isometry::fromEulerAngles(M_PI / 2., M_PI / 4., M_PI / 8.)
+                       .rotation()};
+
+  Vector3Batch input;
+  for (int i = 0; i < 100; ++i) {
+    input.push_back(Vector3(i, -2. * i, 0.5 * i));
+  }
+
+  Vector3Batch output;
+  t.transform(input, output);
+  ASSERT_EQ(output.size(), input.size());
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(output.get(i), t * input.get(i));
+  }
+
+  Vector3Batch in_place{input};
+  t.transform(in_place);
+  ASSERT_EQ(in_place.size(), input.size());
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(in_place.get(i), t * input.get(i));
+  }
+
+  // Aliasing the input and the output behaves as the in-place overload.
+  Vector3Batch aliased{input};
+  t.transform(aliased, aliased);
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(aliased.get(i), in_place.get(i));
+  }
+
+  Vector3Batch empty;
+  t.transform(empty, output);
+  EXPECT_TRUE(output.empty());
+}
+
+GTEST_TEST(Vector3BatchTest, MemoryResources) {
+  // A null upstream makes any allocation that misses the arena throw.
+  alignas(8) unsigned char buffer[4096];
+  std::pmr::monotonic_buffer_resource arena{
+      buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+  Vector3Batch batch{&arena};
+  EXPECT_EQ(batch.resource(), &arena);
+  for (int i = 0; i < 10; ++i) {
+    batch.push_back(Vector3(i, 2. * i, 3. * i));
+  }
+  EXPECT_EQ(batch.get(9), Vector3(9., 18., 27.));
+  EXPECT_THROW(batch.resize(1000), std::bad_alloc);
+
+  const Vector3Batch sized{16, &arena};
+  EXPECT_EQ(sized.size(), 16u);
+  EXPECT_EQ(sized.resource(), &arena);
+  EXPECT_EQ(Vector3Batch{}.resource(), std::pmr::get_default_resource());
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace math
+}  // namespace ekumen
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}